@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""Stress the file cache of spark_memcached_wrapper with concurrent runs.
+
+This runs --jobs instances of spark_memcached_wrapper at a time, as
+gnatprove does with -j, on --files generated input files, with a file
+cache in a temporary directory, in three phases:
+
+  cold   each input is seen for the first time, so each run misses, runs
+         one of the fake provers of this directory in turn and stores its
+         answer;
+  warm   the same inputs again, so each run should hit;
+  churn  --files new inputs for which the wrapped tool is "cat", so that
+         each entry has the size of its input, with the size of the cache
+         limited to --max-size megabytes, half of the size of the inputs,
+         and the warm phase repeated in the middle, so that entries are
+         evicted while others are stored and looked up.
+
+For each phase we report the wall-clock time, the runs per second and the
+hits and misses recorded in the GNATPROVE_CACHE_STATS file.  We check
+that each run printed the answer of the tool, that no temporary file is
+left in the cache and that the size of the cache after the churn phase is
+at most --max-size.  The exit status is nonzero if a check fails.
+"""
+
+import argparse
+import concurrent.futures
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+PROVERS = ["fake_alt-ergo", "fake_cvc4", "fake_cvc5", "fake_z3"]
+
+
+def make_inputs(directory, prefix, count, size, seed):
+    """Create COUNT files of SIZE bytes of random text in DIRECTORY."""
+    rng = random.Random(seed)
+    alphabet = b"abcdefghijklmnopqrstuvwxyz ()\n"
+    table = bytes(alphabet[i % len(alphabet)] for i in range(256))
+    files = []
+    for i in range(count):
+        path = os.path.join(directory, "%s%05d.smt2" % (prefix, i))
+        with open(path, "wb") as fd:
+            fd.write(rng.randbytes(size).translate(table))
+        files.append(path)
+    return files
+
+
+def tree_size(directory):
+    """Return the total size of the files under DIRECTORY and the number of
+    temporary files among them."""
+    total = tmp = 0
+    for root, _, names in os.walk(directory):
+        for name in names:
+            total += os.path.getsize(os.path.join(root, name))
+            tmp += name.endswith(".tmp")
+    return total, tmp
+
+
+def run_phase(args, name, jobs, env):
+    """Run the wrapper on each of JOBS, a list of (tool command, expected
+    output), and report on it.  Return the number of failed runs."""
+    stats = env["GNATPROVE_CACHE_STATS"]
+    if os.path.exists(stats):
+        os.remove(stats)
+
+    def one(job):
+        cmd, expected = job
+        res = subprocess.run(
+            [args.wrapper, "stress", "file:" + args.cache] + cmd,
+            env=env, capture_output=True, text=True)
+        return res.returncode == 0 and res.stdout.strip() == expected
+
+    start = time.monotonic()
+    with concurrent.futures.ThreadPoolExecutor(args.jobs) as pool:
+        failed = sum(not ok for ok in pool.map(one, jobs))
+    elapsed = time.monotonic() - start
+
+    counts = {"hit": 0, "miss": 0}
+    if os.path.exists(stats):
+        with open(stats) as fd:
+            for line in fd:
+                kind = line.split("\t", 1)[0]
+                counts[kind] = counts.get(kind, 0) + 1
+
+    print("%-6s %6d %9.2fs %9.1f %7d %7d %7d"
+          % (name, len(jobs), elapsed, len(jobs) / elapsed, counts["hit"],
+             counts["miss"], failed))
+    return failed
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Stress the file cache of spark_memcached_wrapper.")
+    parser.add_argument("--wrapper",
+                        default=os.path.join(HERE, "..", "install", "bin",
+                                             "spark_memcached_wrapper"),
+                        help="spark_memcached_wrapper to use")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(),
+                        help="number of concurrent runs (default: one per "
+                        "CPU)")
+    parser.add_argument("--files", type=int, default=2000,
+                        help="number of inputs of each phase (default 2000)")
+    parser.add_argument("--file-size", type=int, default=16,
+                        help="size of each input in KB (default 16)")
+    parser.add_argument("--max-size", type=int, default=0,
+                        help="size limit of the cache in MB for the churn "
+                        "phase (default: half the size of its inputs)")
+    args = parser.parse_args()
+
+    size = args.file_size * 1024
+    if args.max_size == 0:
+        args.max_size = max(1, args.files * size // 2 // (1024 * 1024))
+
+    tmpdir = tempfile.mkdtemp(prefix="cache-stress-")
+    args.cache = os.path.join(tmpdir, "cache")
+    os.makedirs(args.cache)
+    env = dict(os.environ,
+               GNATPROVE_CACHE_STATS=os.path.join(tmpdir, "stats"))
+    env.pop("GNATPROVE_FILE_CACHE_MAX_SIZE", None)
+
+    try:
+        # The answer of a fake prover doesn't depend on its input
+        answers = {p: subprocess.run(
+            ["bash", os.path.join(HERE, p)], capture_output=True,
+            text=True, check=True).stdout.strip() for p in PROVERS}
+
+        inputs = make_inputs(tmpdir, "in", args.files, size, 1)
+        prove = [(["bash", os.path.join(HERE, p), f], answers[p])
+                 for p, f in zip(PROVERS * len(inputs), inputs)]
+
+        print("%-6s %6s %10s %9s %7s %7s %7s"
+              % ("phase", "runs", "time", "runs/s", "hits", "misses",
+                 "failed"))
+        failed = run_phase(args, "cold", prove, env)
+        failed += run_phase(args, "warm", prove, env)
+
+        churn = make_inputs(tmpdir, "churn", args.files, size, 2)
+        contents = {}
+        for f in churn:
+            with open(f) as fd:
+                contents[f] = fd.read().strip()
+        cat = [(["cat", f], contents[f]) for f in churn]
+        half = len(cat) // 2
+        limited = dict(env, GNATPROVE_FILE_CACHE_MAX_SIZE=str(args.max_size))
+        failed += run_phase(args, "churn", cat[:half], limited)
+        failed += run_phase(args, "warm", prove, limited)
+        failed += run_phase(args, "churn", cat[half:], limited)
+
+        total, tmp = tree_size(args.cache)
+        print()
+        print("cache size after churn: %.1f MB for a limit of %d MB, "
+              "%d temporary files left"
+              % (total / (1024 * 1024), args.max_size, tmp))
+        status = 0
+        if failed:
+            print("FAILED: %d runs printed a wrong answer" % failed)
+            status = 1
+        if tmp:
+            print("FAILED: temporary files left in the cache")
+            status = 1
+        if total > args.max_size * 1024 * 1024:
+            print("FAILED: the cache is larger than its limit")
+            status = 1
+        return status
+    finally:
+        shutil.rmtree(tmpdir)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Measure what computing the cache key costs spark_memcached_wrapper.
+
+For each size of input file, we run spark_memcached_wrapper --runs times
+on an input of that size, wrapping one of the fake provers of this
+directory, with a file cache that already holds the answer.  Each run is
+then a hit, so its time is that of starting the wrapper, computing the key
+and reading the cache.  We run it once with the inputs hashed on each run
+and once with the digest memo shared by the runs of a gnatprove run
+(GNATPROVE_DIGEST_MEMO), and report the best times and, from the
+difference with an empty input, the throughput of hashing.  For
+reference, we also report the time taken by Python's SHA-1, which uses
+OpenSSL, on the same input.
+
+The default sizes span those of the .gnat-json and .mlw files of real
+units, from a few KB to tens of MB.
+"""
+
+import argparse
+import hashlib
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+PROVER = os.path.join(HERE, "fake_z3")
+SIZES = [0, 16 << 10, 256 << 10, 1 << 20, 4 << 20, 16 << 20, 64 << 20]
+
+
+def best_time(args, runs, inp, env):
+    """Return the best wall-clock time of RUNS runs of the wrapper on INP."""
+    best = None
+    for _ in range(runs):
+        start = time.monotonic()
+        subprocess.run([args.wrapper, "bench", "file:" + args.cache, "bash",
+                        PROVER, inp], env=env, check=True,
+                       stdout=subprocess.DEVNULL)
+        elapsed = time.monotonic() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def sha1_time(path):
+    """Return the time taken by hashlib to hash the file at PATH."""
+    start = time.monotonic()
+    with open(path, "rb") as fd:
+        hashlib.sha1(fd.read()).digest()
+    return time.monotonic() - start
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Measure the cost of the key of spark_memcached_wrapper.")
+    parser.add_argument("--wrapper",
+                        default=os.path.join(HERE, "..", "install", "bin",
+                                             "spark_memcached_wrapper"),
+                        help="spark_memcached_wrapper to use")
+    parser.add_argument("--runs", type=int, default=20,
+                        help="number of runs for each size (default 20)")
+    parser.add_argument("sizes", nargs="*", type=int, default=SIZES,
+                        help="sizes of the inputs in bytes (default: "
+                        "0 to 64 MB)")
+    args = parser.parse_args()
+    if 0 not in args.sizes:
+        args.sizes.insert(0, 0)
+
+    tmpdir = tempfile.mkdtemp(prefix="key-hash-")
+    args.cache = os.path.join(tmpdir, "cache")
+    os.makedirs(args.cache)
+    env = dict(os.environ)
+    for var in ("GNATPROVE_CACHE_STATS", "GNATPROVE_DIGEST_MEMO",
+                "GNATPROVE_FILE_CACHE_MAX_SIZE"):
+        env.pop(var, None)
+    memo_env = dict(env, GNATPROVE_DIGEST_MEMO=os.path.join(tmpdir, "memo"))
+
+    try:
+        inputs = {}
+        for size in args.sizes:
+            inputs[size] = os.path.join(tmpdir, "in%d.gnat-json" % size)
+            with open(inputs[size], "wb") as fd:
+                fd.write(os.urandom(size))
+
+        # The memo only records the digests of files that haven't changed
+        # for two seconds.
+
+        time.sleep(2.5)
+        for size in args.sizes:
+            best_time(args, 1, inputs[size], env)
+            best_time(args, 1, inputs[size], memo_env)
+
+        print("%10s %10s %10s %10s %10s"
+              % ("size", "direct", "memo", "hash MB/s", "hashlib"))
+        base = None
+        for size in args.sizes:
+            direct = best_time(args, args.runs, inputs[size], env)
+            memo = best_time(args, args.runs, inputs[size], memo_env)
+            if base is None:
+                base = direct
+            rate = ("%10.0f" % (size / (direct - base) / (1 << 20))
+                    if size and direct > base else "%10s" % "-")
+            print("%10d %9.2fms %9.2fms %s %9.2fms"
+                  % (size, direct * 1e3, memo * 1e3, rate,
+                     sha1_time(inputs[size]) * 1e3))
+        return 0
+    finally:
+        shutil.rmtree(tmpdir)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""Measure the elaboration of a large array aggregate with static rows.
+
+This generates a function that declares a --size by --size table of
+32-bit integers initialized by an aggregate whose first row depends on a
+parameter, so that the aggregate isn't static as a whole, and whose other
+rows are distinct static aggregates.  The function then reads the table
+at indices that depend on its parameter, through a function that can't
+be inlined so that the optimizer can't fold the table away.
+
+The function is compiled by llvm-gcc and by --baseline, for example an
+llvm-gcc built before the static rows of such aggregates were copied from
+constant globals, and each build is linked with ccg-bench/bench_main.c,
+which calls it --runs times and reports the best time.  We report the
+time to elaborate and read the table and the size of the code of each
+build, and the ratio of the first to the baseline.  The exit status is
+nonzero if a build or a result is wrong.
+"""
+
+import argparse
+import os
+import shlex
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+M64 = (1 << 64) - 1
+
+
+def write_source(path, size):
+    """Write the function described above, with a SIZE by SIZE table, to
+    PATH."""
+    rows = ["      1 => (" + ", ".join(["S"] * size) + ")"]
+    for r in range(2, size + 1):
+        first = (r - 1) * size + 1
+        rows.append("      %d => (%s)"
+                    % (r, ", ".join(str(v) for v in
+                                    range(first, first + size))))
+
+    with open(path, "w") as fd:
+        fd.write("""with Interfaces; use Interfaces;
+
+function Table_Kernel (Scale : Integer) return Unsigned_64
+  with Export, Convention => C, External_Name => "kernel_run"
+is
+   N : constant := %d;
+   type Table is array (1 .. N, 1 .. N) of Integer_32;
+
+   function Get (T : Table; I, J : Integer) return Integer_32
+     with No_Inline;
+
+   function Get (T : Table; I, J : Integer) return Integer_32 is
+     (T (I, J));
+
+   S      : constant Integer_32 := Integer_32 (Scale);
+   T      : constant Table      :=
+     (%s);
+   Result : Unsigned_64         := 0;
+
+begin
+   for K in 1 .. N loop
+      Result := Result * 31
+        + Unsigned_64 (Get (T, K, (K * 37 + Scale) mod N + 1));
+   end loop;
+
+   return Result;
+end Table_Kernel;
+""" % (size, ",\n".join(rows).lstrip()))
+
+
+def oracle(size, scale):
+    """What the function returns for SCALE."""
+    result = 0
+    for k in range(1, size + 1):
+        col = (k * 37 + scale) % size + 1
+        value = scale if k == 1 else (k - 1) * size + col
+        result = (result * 31 + value) & M64
+    return result
+
+
+def run(cmd, cwd, log):
+    """Run CMD in CWD, appending its output to LOG, and return whether it
+    succeeded."""
+    with open(log, "a") as fd:
+        fd.write("$ %s\n" % " ".join(shlex.quote(c) for c in cmd))
+        fd.flush()
+        return subprocess.run(cmd, cwd=cwd, stdout=fd,
+                              stderr=subprocess.STDOUT).returncode == 0
+
+
+def text_size(obj):
+    """Return the size of the code in the object file OBJ."""
+    out = subprocess.run(["size", obj], check=True, capture_output=True,
+                         text=True).stdout
+    return int(out.splitlines()[1].split()[0])
+
+
+def build_and_run(args, name, gcc, src, expected):
+    """Build SRC with GCC in a subdirectory NAME of the build directory and
+    return the best time and the code size, or None if that failed."""
+    wdir = os.path.join(args.build_dir, name)
+    log = os.path.join(wdir, "build.log")
+    os.makedirs(wdir, exist_ok=True)
+    if os.path.exists(log):
+        os.remove(log)
+
+    if not (run([gcc, "-c"] + args.adaflags + [src], wdir, log)
+            and run([args.cc, "-O2", "-o", "bench",
+                     os.path.join(HERE, "ccg-bench", "bench_main.c"),
+                     "table_kernel.o",
+                     os.path.join(args.adalib, "libgnat.a"), "-lm",
+                     "-lpthread", "-ldl"], wdir, log)):
+        print("%s build failed, see %s" % (name, log), file=sys.stderr)
+        return None
+
+    res = subprocess.run([os.path.join(wdir, "bench"), str(args.scale),
+                          str(args.runs), str(expected)],
+                         capture_output=True, text=True)
+    if res.returncode != 0:
+        print("%s: %s" % (name, res.stderr.strip()), file=sys.stderr)
+        return None
+    return float(res.stdout), text_size(os.path.join(wdir, "table_kernel.o"))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Measure the elaboration of an aggregate with static "
+        "rows.")
+    parser.add_argument("--gcc", default=os.path.join(HERE, "bin", "llvm-gcc"),
+                        help="llvm-gcc to measure")
+    parser.add_argument("--baseline", required=True,
+                        help="llvm-gcc to compare with")
+    parser.add_argument("--cc", default="cc", help="host C compiler")
+    parser.add_argument("--adalib",
+                        default=os.path.join(HERE, "lib", "rts-native",
+                                             "adalib"),
+                        help="directory of the libgnat.a to link with")
+    parser.add_argument("--adaflags", default="-O2",
+                        help="switches for llvm-gcc (default -O2)")
+    parser.add_argument("--size", type=int, default=256,
+                        help="number of rows and columns of the table "
+                        "(default 256, for 64K components)")
+    parser.add_argument("--scale", type=int, default=12345,
+                        help="value of the first row (default 12345)")
+    parser.add_argument("--runs", type=int, default=200,
+                        help="number of runs of each build (default 200)")
+    parser.add_argument("--build-dir", default="aggregate-bench-build",
+                        help="directory for the builds")
+    args = parser.parse_args()
+    args.adaflags = shlex.split(args.adaflags)
+    args.build_dir = os.path.abspath(args.build_dir)
+
+    os.makedirs(args.build_dir, exist_ok=True)
+    src = os.path.join(args.build_dir, "table_kernel.adb")
+    write_source(src, args.size)
+    expected = oracle(args.size, args.scale)
+
+    results = {}
+    for name, gcc in (("baseline", args.baseline), ("new", args.gcc)):
+        results[name] = build_and_run(args, name, gcc, src, expected)
+    if None in results.values():
+        return 1
+
+    (base_time, base_size), (new_time, new_size) = (results["baseline"],
+                                                    results["new"])
+    print("%-10s %12s %12s" % ("", "time", "code size"))
+    print("%-10s %10.1fus %12d" % ("baseline", base_time * 1e6, base_size))
+    print("%-10s %10.1fus %12d" % ("new", new_time * 1e6, new_size))
+    print("%-10s %12.2f %12.2f" % ("ratio", new_time / base_time,
+                                   new_size / base_size))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""Measure the time the C generator takes to write a large unit.
+
+This generates a package with --subprograms small subprograms, whose C
+is many tens of thousands of lines, and compiles it with llvm-gcc -emit-c,
+both as is and with -fno-c-buffer, which writes each line of C to the
+file as soon as it's complete instead of collecting the text in a large
+buffer.  Each compilation is run --runs times and we report the shortest
+wall-clock time of each, the ratio of the first to the second and, if
+strace is available, the number of write system calls each made.
+
+The C written must be the same either way.  The exit status is nonzero if
+a compilation fails or if it isn't.
+"""
+
+import argparse
+import filecmp
+import os
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+MODES = {
+    "buffered": [],
+    "unbuffered": ["-fno-c-buffer"],
+}
+
+
+def write_source(path, subprograms):
+    """Write the package described above, with SUBPROGRAMS subprograms, to
+    PATH and its spec next to it."""
+    with open(path[:-1] + "s", "w") as fd:
+        fd.write("package Big_Unit is\n")
+        for k in range(1, subprograms + 1):
+            fd.write("   function F_%d (X, Y : Integer) return Integer;\n" % k)
+        fd.write("end Big_Unit;\n")
+
+    with open(path, "w") as fd:
+        fd.write("package body Big_Unit is\n")
+        for k in range(1, subprograms + 1):
+            fd.write("""
+   function F_{0} (X, Y : Integer) return Integer is
+      R : Integer := X;
+
+   begin
+      for J in 1 .. Y loop
+         if R mod {1} = 0 then
+            R := R / 2 + J;
+         else
+            R := R * 3 + {0};
+         end if;
+      end loop;
+
+      return R;
+   end F_{0};
+""".format(k, k % 7 + 2))
+        fd.write("\nend Big_Unit;\n")
+
+
+def compile_c(args, mode, wdir, cmd):
+    """Run CMD, which compiles the unit in MODE, in WDIR --runs times and
+    return the best time, or None if it failed."""
+    log = os.path.join(wdir, "build.log")
+    best = None
+    for _ in range(args.runs):
+        start = time.monotonic()
+        with open(log, "w") as fd:
+            res = subprocess.run(cmd, cwd=wdir, stdout=fd,
+                                 stderr=subprocess.STDOUT)
+        elapsed = time.monotonic() - start
+        if res.returncode != 0:
+            print("%s compilation failed, see %s" % (mode, log),
+                  file=sys.stderr)
+            return None
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def count_writes(wdir, cmd):
+    """Return the number of write system calls CMD makes in WDIR, or None
+    if we can't tell."""
+    if shutil.which("strace") is None:
+        return None
+    res = subprocess.run(["strace", "-f", "-c", "-e", "trace=write"] + cmd,
+                         cwd=wdir, capture_output=True, text=True)
+    match = re.search(r"^\s*[\d.]+\s+[\d.]+\s+\d+\s+(\d+)\s+(?:\d+\s+)?write$",
+                      res.stderr, re.MULTILINE)
+    return int(match.group(1)) if match else None
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Measure the time the C generator takes to write a "
+        "large unit.")
+    parser.add_argument("--gcc", default=os.path.join(HERE, "bin", "llvm-gcc"),
+                        help="llvm-gcc to use")
+    parser.add_argument("--adaflags", default="-O0",
+                        help="switches for llvm-gcc (default -O0, so that "
+                        "optimization doesn't dominate)")
+    parser.add_argument("--subprograms", type=int, default=5000,
+                        help="number of subprograms in the unit "
+                        "(default 5000)")
+    parser.add_argument("--runs", type=int, default=5,
+                        help="number of compilations in each mode "
+                        "(default 5)")
+    parser.add_argument("--build-dir", default="c-write-bench-build",
+                        help="directory for the builds")
+    args = parser.parse_args()
+    args.adaflags = shlex.split(args.adaflags)
+    args.build_dir = os.path.abspath(args.build_dir)
+
+    results = {}
+    for mode, switches in MODES.items():
+        wdir = os.path.join(args.build_dir, mode)
+        os.makedirs(wdir, exist_ok=True)
+        write_source(os.path.join(wdir, "big_unit.adb"), args.subprograms)
+        cmd = ([args.gcc, "-c", "-emit-c"] + args.adaflags + switches
+               + ["big_unit.adb"])
+        best = compile_c(args, mode, wdir, cmd)
+        if best is None:
+            return 1
+        results[mode] = (best, count_writes(wdir, cmd),
+                         os.path.getsize(os.path.join(wdir, "big_unit.c")))
+
+    if not filecmp.cmp(os.path.join(args.build_dir, "buffered", "big_unit.c"),
+                       os.path.join(args.build_dir, "unbuffered",
+                                    "big_unit.c"), shallow=False):
+        print("the C written differs with -fno-c-buffer", file=sys.stderr)
+        return 1
+
+    print("%-12s %10s %10s %12s" % ("", "time", "writes", "C size"))
+    for mode, (best, writes, size) in results.items():
+        print("%-12s %9.3fs %10s %12d"
+              % (mode, best, "?" if writes is None else writes, size))
+    print("%-12s %10.2f" % ("ratio", results["buffered"][0]
+                            / results["unbuffered"][0]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
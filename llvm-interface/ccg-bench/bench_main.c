@@ -0,0 +1,83 @@
+/****************************************************************************
+ *                                                                          *
+ *                            GNAT-LLVM COMPONENTS                          *
+ *                                                                          *
+ *                           B E N C H _ M A I N                            *
+ *                                                                          *
+ *                          C Implementation File                           *
+ *                                                                          *
+ *                        Copyright (C) 2023, AdaCore                       *
+ *                                                                          *
+ * This is free software;  you can redistribute it  and/or modify it  under *
+ * terms of the  GNU General Public License as published  by the Free Soft- *
+ * ware  Foundation;  either version 3,  or (at your option) any later ver- *
+ * sion.  This software is distributed in the hope  that it will be useful, *
+ * but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- *
+ * TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public *
+ * License for  more details.  You should have  received  a copy of the GNU *
+ * General  Public  License  distributed  with  this  software;   see  file *
+ * COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy *
+ * of the license.                                                          *
+ *                                                                          *
+ ****************************************************************************/
+
+/* This is the main program of each benchmark of the C generator.  It's
+   linked with one kernel, compiled either to an object file or to C, and
+   run as "bench SCALE RUNS EXPECTED".  It calls the kernel RUNS times with
+   SCALE, checks that each call returns EXPECTED and writes the shortest
+   time a call took, in seconds.  */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+extern uint64_t kernel_run (int);
+
+static double
+now (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int
+main (int argc, char **argv)
+{
+  int scale, runs, i;
+  uint64_t expected, result;
+  double best = -1.0;
+
+  if (argc != 4)
+    {
+      fprintf (stderr, "usage: %s SCALE RUNS EXPECTED\n", argv[0]);
+      return 2;
+    }
+
+  scale = atoi (argv[1]);
+  runs = atoi (argv[2]);
+  expected = strtoull (argv[3], NULL, 10);
+
+  for (i = 0; i < runs; i++)
+    {
+      double start = now (), elapsed;
+
+      result = kernel_run (scale);
+      elapsed = now () - start;
+
+      if (result != expected)
+	{
+	  fprintf (stderr, "wrong result %" PRIu64 ", expected %" PRIu64 "\n",
+		   result, expected);
+	  return 1;
+	}
+
+      if (best < 0 || elapsed < best)
+	best = elapsed;
+    }
+
+  printf ("%.6f\n", best);
+  return 0;
+}
@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+"""Compare the code of the C generator with that of native code generation.
+
+Each kernel of this directory is built twice: to an object file by
+llvm-gcc and to C by llvm-gcc -emit-c, which is then compiled by the host
+C compiler.  Both are linked with bench_main.c, which runs the kernel and
+checks its result against the oracle, a Python version of the kernel
+below.  For each kernel, we report the best run time and the size of the
+code of both builds, and the ratio of the C build to the native one.  We
+then report the differences in the runtime checks remaining in the two
+builds, as found by compare_checks.py from the -fcheck-stats output.
+
+With --compare, we compare two other builds instead, for example
+"--compare=c-goto,c" compares the C generator's output with natural loops
+written as labels and gotos (-fno-c-loops) to its output with C loops and
+"--compare=native-warm,native" compares native code where the code that
+raises an exception for a failed check isn't marked cold
+(-fno-cold-checks) to the default, where it is.
+
+The kernels only use modular integer arithmetic so that their results
+don't depend on how the C compiler contracts or reorders floating-point
+operations.  The exit status is nonzero if a build or a result is wrong.
+"""
+
+import argparse
+import os
+import shlex
+import subprocess
+import sys
+import zlib
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+M32 = (1 << 32) - 1
+M64 = (1 << 64) - 1
+
+
+def fold(values):
+    """Hash VALUES the way the kernels do."""
+    result = 0
+    for v in values:
+        result = (result * 31 + v) & M64
+    return result
+
+
+def lcg(n):
+    """The pseudo-random numbers used by the kernels."""
+    x = 1
+    for _ in range(n):
+        x = (x * 1103515245 + 12345) & M32
+        yield x
+
+
+def sieve(scale):
+    limit = 1000 * scale
+    composite = bytearray(limit + 1)
+    for i in range(2, limit + 1):
+        if not composite[i] and i * i <= limit:
+            composite[i * i::i] = b"\1" * len(range(i * i, limit + 1, i))
+    return fold(i for i in range(2, limit + 1) if not composite[i])
+
+
+def matmul(scale):
+    r = range(1, scale + 1)
+    a = [[(i * 7 + j * 3) % 1000 for j in r] for i in r]
+    b = [[(i * 5 + j * 11) % 1000 for j in r] for i in r]
+    cols = list(zip(*b))
+    return fold(sum(x * y for x, y in zip(row, col)) & M32
+                for row in a for col in cols)
+
+
+def crc32(scale):
+    data = bytes((x >> 16) & 0xFF for x in lcg(1024 * scale))
+    return zlib.crc32(data)
+
+
+def heapsort(scale):
+    return fold(sorted(lcg(1000 * scale)))
+
+
+def gather(scale):
+    n = 4096
+    xs = list(lcg(n))
+    perm = [(x >> 16) % n for x in xs]
+    data = [(x >> 8) & 0xFF for x in xs]
+    total = 0
+    sums = []
+    for _ in range(scale):
+        for p in perm:
+            total = (total + data[p]) % 1000003
+            data[p] = total % 256
+        sums.append(total)
+    return fold(sums)
+
+
+# The kernels, with the scale at which we run each of them and its oracle
+
+KERNELS = {
+    "sieve": (1000, sieve),
+    "matmul": (200, matmul),
+    "crc32": (4096, crc32),
+    "heapsort": (500, heapsort),
+    "gather": (500, gather),
+}
+
+# The ways we can build a kernel: whether through C and the additional
+# switches for llvm-gcc
+
+MODES = {
+    "native": (False, []),
+    "native-warm": (False, ["-fno-cold-checks"]),
+    "c": (True, []),
+    "c-goto": (True, ["-fno-c-loops"]),
+}
+
+
+def run(cmd, cwd, log):
+    """Run CMD in CWD, appending its output to LOG, and return whether it
+    succeeded."""
+    with open(log, "a") as fd:
+        fd.write("$ %s\n" % " ".join(shlex.quote(c) for c in cmd))
+        fd.flush()
+        return subprocess.run(cmd, cwd=cwd, stdout=fd,
+                              stderr=subprocess.STDOUT).returncode == 0
+
+
+def text_size(obj):
+    """Return the size of the code in the object file OBJ."""
+    out = subprocess.run(["size", obj], check=True, capture_output=True,
+                         text=True).stdout
+    return int(out.splitlines()[1].split()[0])
+
+
+def build(args, kernel, mode, main_obj):
+    """Build KERNEL in MODE, one of MODES, and return the directory where
+    we did so, or None if the build failed."""
+    wdir = os.path.join(args.build_dir, mode)
+    log = os.path.join(wdir, kernel + ".log")
+    src = os.path.join(HERE, kernel + ".adb")
+    os.makedirs(wdir, exist_ok=True)
+    if os.path.exists(log):
+        os.remove(log)
+
+    emit_c, switches = MODES[mode]
+    ada = ([args.gcc, "-c", "-fcheck-stats", "-I" + HERE] + args.adaflags
+           + switches)
+    if not emit_c:
+        ok = run(ada + [src], wdir, log)
+    else:
+        ok = (run(ada + ["-emit-c"] + args.ccg_switches + [src], wdir, log)
+              and run([args.cc, "-c"] + args.cflags + [kernel + ".c"],
+                      wdir, log))
+
+    return wdir if ok and run(
+        [args.cc, "-o", kernel, main_obj, kernel + ".o",
+         os.path.join(args.adalib, "libgnat.a"), "-lm", "-lpthread",
+         "-ldl"], wdir, log) else None
+
+
+def measure(args, kernel, wdir, expected):
+    """Run the benchmark built in WDIR and return its best time, or None
+    if it failed."""
+    scale = KERNELS[kernel][0]
+    res = subprocess.run([os.path.join(wdir, kernel), str(scale),
+                          str(args.runs), str(expected)],
+                         capture_output=True, text=True)
+    if res.returncode != 0:
+        print("%s: %s" % (os.path.join(wdir, kernel), res.stderr.strip()),
+              file=sys.stderr)
+        return None
+    return float(res.stdout)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare the C generator with native code generation.")
+    parser.add_argument("--gcc",
+                        default=os.path.join(HERE, "..", "bin", "llvm-gcc"),
+                        help="llvm-gcc to use")
+    parser.add_argument("--cc", default="cc", help="host C compiler")
+    parser.add_argument("--adalib",
+                        default=os.path.join(HERE, "..", "lib", "rts-native",
+                                             "adalib"),
+                        help="directory of the libgnat.a to link with")
+    parser.add_argument("--adaflags", default="-O2",
+                        help="switches for llvm-gcc (default -O2)")
+    parser.add_argument("--ccg-switches", default="",
+                        help="additional switches for llvm-gcc when "
+                        "generating C")
+    parser.add_argument("--cflags", default="-O2",
+                        help="switches for the C compiler (default -O2)")
+    parser.add_argument("--runs", type=int, default=5,
+                        help="number of runs of each kernel (default 5)")
+    parser.add_argument("--build-dir", default="ccg-bench-build",
+                        help="directory for the builds")
+    parser.add_argument("--compare", default="native,c",
+                        help="the two builds to compare, among %s "
+                        "(default native,c)" % ", ".join(MODES))
+    parser.add_argument("kernels", nargs="*", default=sorted(KERNELS),
+                        help="kernels to run (default all)")
+    args = parser.parse_args()
+    args.adaflags = shlex.split(args.adaflags)
+    args.ccg_switches = shlex.split(args.ccg_switches)
+    args.cflags = shlex.split(args.cflags)
+    args.build_dir = os.path.abspath(args.build_dir)
+
+    for kernel in args.kernels:
+        if kernel not in KERNELS:
+            parser.error("unknown kernel %s" % kernel)
+
+    modes = args.compare.split(",")
+    if len(modes) != 2 or modes[0] == modes[1] or not set(modes) <= set(MODES):
+        parser.error("invalid builds to compare: %s" % args.compare)
+    first, second = modes
+    ratio = "%s/%s" % (second, first)
+
+    os.makedirs(args.build_dir, exist_ok=True)
+    main_obj = os.path.join(args.build_dir, "bench_main.o")
+    subprocess.run([args.cc, "-c", "-O2", "-o", main_obj,
+                    os.path.join(HERE, "bench_main.c")], check=True)
+
+    status = 0
+    print("%-10s %29s %31s" % ("", "run time", "code size"))
+    print("%-10s %10s %10s %8s %10s %10s %8s"
+          % ("kernel", first, second, "ratio", first, second, "ratio"))
+    for kernel in args.kernels:
+        scale, oracle = KERNELS[kernel]
+        expected = oracle(scale)
+        times = {}
+        sizes = {}
+        for mode in modes:
+            wdir = build(args, kernel, mode, main_obj)
+            if wdir is None:
+                print("%s: %s build failed, see %s"
+                      % (kernel, mode, os.path.join(args.build_dir, mode,
+                                                    kernel + ".log")),
+                      file=sys.stderr)
+            else:
+                times[mode] = measure(args, kernel, wdir, expected)
+                sizes[mode] = text_size(os.path.join(wdir, kernel + ".o"))
+
+        if len(times) != 2 or None in times.values():
+            status = 1
+            continue
+
+        print("%-10s %9.4fs %9.4fs %8.2f %10d %10d %8.2f"
+              % (kernel, times[first], times[second],
+                 times[second] / times[first], sizes[first], sizes[second],
+                 sizes[second] / sizes[first]))
+
+    print("(ratios are %s)" % ratio)
+    print()
+    print("Remaining checks (%s, %s):" % (first, second))
+    sys.stdout.flush()
+    subprocess.run([sys.executable, os.path.join(HERE, "..",
+                                                 "compare_checks.py"),
+                    os.path.join(args.build_dir, first),
+                    os.path.join(args.build_dir, second)])
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
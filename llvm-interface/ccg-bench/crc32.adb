@@ -0,0 +1,50 @@
+------------------------------------------------------------------------------
+--                             G N A T - L L V M                            --
+--                                                                          --
+--                       Copyright (C) 2023, AdaCore                        --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.  You should have  received  a copy of the GNU --
+-- General  Public  License  distributed  with  this  software;   see  file --
+-- COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy --
+-- of the license.                                                          --
+------------------------------------------------------------------------------
+
+function CRC32 (Scale : Integer) return Unsigned_64 is
+   type Byte_Array is array (1 .. 1_024 * Scale) of Unsigned_8;
+
+   Data  : Byte_Array;
+   Table : array (Unsigned_8) of Unsigned_32;
+   X     : Unsigned_32 := 1;
+   C     : Unsigned_32;
+
+begin
+   for J in Data'Range loop
+      X := X * 1_103_515_245 + 12_345;
+      Data (J) := Unsigned_8 (Shift_Right (X, 16) and 16#FF#);
+   end loop;
+
+   for N in Table'Range loop
+      C := Unsigned_32 (N);
+
+      for K in 1 .. 8 loop
+         C := (if   (C and 1) /= 0 then 16#EDB8_8320# xor Shift_Right (C, 1)
+               else Shift_Right (C, 1));
+      end loop;
+
+      Table (N) := C;
+   end loop;
+
+   C := 16#FFFF_FFFF#;
+
+   for B of Data loop
+      C := Table (Unsigned_8 (C and 16#FF#) xor B) xor Shift_Right (C, 8);
+   end loop;
+
+   return Unsigned_64 (C xor 16#FFFF_FFFF#);
+end CRC32;
@@ -0,0 +1,44 @@
+------------------------------------------------------------------------------
+--                             G N A T - L L V M                            --
+--                                                                          --
+--                       Copyright (C) 2023, AdaCore                        --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.  You should have  received  a copy of the GNU --
+-- General  Public  License  distributed  with  this  software;   see  file --
+-- COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy --
+-- of the license.                                                          --
+------------------------------------------------------------------------------
+function Gather (Scale : Integer) return Unsigned_64 is
+   N : constant := 4_096;
+   type Index is range 1 .. N;
+
+   Perm   : array (Index) of Integer;
+   Data   : array (Index) of Integer;
+   X      : Unsigned_32 := 1;
+   Sum    : Integer     := 0;
+   Result : Unsigned_64 := 0;
+
+begin
+   for J in Perm'Range loop
+      X := X * 1_103_515_245 + 12_345;
+      Perm (J) := Integer (Shift_Right (X, 16) mod N) + 1;
+      Data (J) := Integer (Shift_Right (X, 8) and 16#FF#);
+   end loop;
+
+   for R in 1 .. Scale loop
+      for P of Perm loop
+         Sum := (Sum + Data (Index (P))) mod 1_000_003;
+         Data (Index (P)) := Sum mod 256;
+      end loop;
+
+      Result := Result * 31 + Unsigned_64 (Sum);
+   end loop;
+
+   return Result;
+end Gather;
@@ -0,0 +1,80 @@
+------------------------------------------------------------------------------
+--                             G N A T - L L V M                            --
+--                                                                          --
+--                       Copyright (C) 2023, AdaCore                        --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.  You should have  received  a copy of the GNU --
+-- General  Public  License  distributed  with  this  software;   see  file --
+-- COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy --
+-- of the license.                                                          --
+------------------------------------------------------------------------------
+
+function Heapsort (Scale : Integer) return Unsigned_64 is
+   type Vector is array (1 .. 1_000 * Scale) of Unsigned_32;
+
+   V      : Vector;
+   X      : Unsigned_32 := 1;
+   Tmp    : Unsigned_32;
+   Last   : Natural;
+   Result : Unsigned_64 := 0;
+
+   procedure Sift_Down (Root, Last : Positive);
+   --  Restore the heap property of V (Root .. Last), assuming it only
+   --  fails at Root.
+
+   ---------------
+   -- Sift_Down --
+   ---------------
+
+   procedure Sift_Down (Root, Last : Positive) is
+      Parent : Positive := Root;
+      Child  : Positive;
+
+   begin
+      while Parent <= Last / 2 loop
+         Child := 2 * Parent;
+
+         if Child < Last and then V (Child) < V (Child + 1) then
+            Child := Child + 1;
+         end if;
+
+         exit when V (Parent) >= V (Child);
+         Tmp        := V (Parent);
+         V (Parent) := V (Child);
+         V (Child)  := Tmp;
+         Parent     := Child;
+      end loop;
+   end Sift_Down;
+
+begin
+   for J in V'Range loop
+      X := X * 1_103_515_245 + 12_345;
+      V (J) := X;
+   end loop;
+
+   for J in reverse 1 .. V'Last / 2 loop
+      Sift_Down (J, V'Last);
+   end loop;
+
+   Last := V'Last;
+
+   while Last > 1 loop
+      Tmp      := V (1);
+      V (1)    := V (Last);
+      V (Last) := Tmp;
+      Last     := Last - 1;
+      Sift_Down (1, Last);
+   end loop;
+
+   for E of V loop
+      Result := Result * 31 + Unsigned_64 (E);
+   end loop;
+
+   return Result;
+end Heapsort;
@@ -0,0 +1,52 @@
+------------------------------------------------------------------------------
+--                             G N A T - L L V M                            --
+--                                                                          --
+--                       Copyright (C) 2023, AdaCore                        --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.  You should have  received  a copy of the GNU --
+-- General  Public  License  distributed  with  this  software;   see  file --
+-- COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy --
+-- of the license.                                                          --
+------------------------------------------------------------------------------
+
+function Matmul (Scale : Integer) return Unsigned_64 is
+   type Matrix is array (1 .. Scale, 1 .. Scale) of Unsigned_32;
+
+   A, B, C : Matrix;
+   Sum     : Unsigned_32;
+   Result  : Unsigned_64 := 0;
+
+begin
+   for I in Matrix'Range (1) loop
+      for J in Matrix'Range (2) loop
+         A (I, J) := Unsigned_32 ((I * 7 + J * 3) mod 1_000);
+         B (I, J) := Unsigned_32 ((I * 5 + J * 11) mod 1_000);
+      end loop;
+   end loop;
+
+   for I in Matrix'Range (1) loop
+      for J in Matrix'Range (2) loop
+         Sum := 0;
+
+         for K in Matrix'Range (2) loop
+            Sum := Sum + A (I, K) * B (K, J);
+         end loop;
+
+         C (I, J) := Sum;
+      end loop;
+   end loop;
+
+   for I in Matrix'Range (1) loop
+      for J in Matrix'Range (2) loop
+         Result := Result * 31 + Unsigned_64 (C (I, J));
+      end loop;
+   end loop;
+
+   return Result;
+end Matmul;
@@ -0,0 +1,42 @@
+------------------------------------------------------------------------------
+--                             G N A T - L L V M                            --
+--                                                                          --
+--                       Copyright (C) 2023, AdaCore                        --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.  You should have  received  a copy of the GNU --
+-- General  Public  License  distributed  with  this  software;   see  file --
+-- COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy --
+-- of the license.                                                          --
+------------------------------------------------------------------------------
+
+function Sieve (Scale : Integer) return Unsigned_64 is
+   Limit     : constant Positive := 1_000 * Scale;
+   Composite : array (2 .. Limit) of Boolean := (others => False);
+   Result    : Unsigned_64 := 0;
+   J         : Positive;
+
+begin
+   for I in Composite'Range loop
+      if not Composite (I) then
+         Result := Result * 31 + Unsigned_64 (I);
+
+         if I <= Limit / I then
+            J := I * I;
+
+            loop
+               Composite (J) := True;
+               exit when J > Limit - I;
+               J := J + I;
+            end loop;
+         end if;
+      end if;
+   end loop;
+
+   return Result;
+end Sieve;
@@ -422,6 +422,14 @@ package body CCG.Codegen is
          Prefer_Packed := True;
       elsif S = "-fno-prefer-packed" then
          Prefer_Packed := False;
+      elsif S = "-fc-loops" then
+         Write_C_Loops := True;
+      elsif S = "-fno-c-loops" then
+         Write_C_Loops := False;
+      elsif S = "-fc-buffer" then
+         Buffer_C_Output := True;
+      elsif S = "-fno-c-buffer" then
+         Buffer_C_Output := False;
       elsif Starts_With (S, "-header-inline=") then
          if Switch_Value (S, "-header-inline=") = "none" then
             Header_Inline := None;
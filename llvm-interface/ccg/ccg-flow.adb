@@ -25,6 +25,7 @@ with Table;
 
 with GNATLLVM.Wrapper; use GNATLLVM.Wrapper;
 
+with CCG.Codegen;      use CCG.Codegen;
 with CCG.Instructions; use CCG.Instructions;
 with CCG.Output;       use CCG.Output;
 with CCG.Subprograms;  use CCG.Subprograms;
@@ -1548,9 +1549,12 @@ package body CCG.Flow is
          "<"          => "<",
          "="          => "=");
       use Output_Flows;
-      To_Output  : Set;
-      Output     : Set;
-      Was_Inline : Set;
+      To_Output    : Set;
+      Output       : Set;
+      Was_Inline   : Set;
+      Current_Loop : Flow_Idx := Empty_Flow_Idx;
+      --  The flow for the header of the innermost loop we're writing, if
+      --  any. A branch to it is a "continue".
 
       ----------------------
       -- Mark_When_Inline --
@@ -1613,6 +1617,12 @@ package body CCG.Flow is
                              Depth       => Depth,
                              Our_Next    => Our_Next);
 
+         --  If this is a branch back to the header of the loop we're in,
+         --  we can just continue the loop.
+
+         elsif Idx = Current_Loop then
+            Output_Stmt ("continue", V => V);
+
          --  Otherwise, write a goto and mark it for output
 
          else
@@ -1667,8 +1677,30 @@ package body CCG.Flow is
          Our_Next    : Flow_Idx := Empty_Flow_Idx;
          Write_Label : Boolean  := True)
       is
-         Was_Same : Boolean := False;
-         T        : Value_T;
+         Is_Loop    : constant Boolean  :=
+           Write_C_Loops and then Depth = 0
+           and then Is_Loop_Header (BB (Idx))
+           and then (Present (First_Line (Idx))
+                       or else Present (First_If (Idx))
+                       or else Present (Case_Expr (Idx)));
+         --  We write a loop around the flow of a loop header unless that
+         --  flow is just a branch, in which case the loop is elsewhere.
+
+         Is_Rotated : constant Boolean  :=
+           Is_Loop and then Present (First_Line (Idx))
+           and then Present (First_If (Idx))
+           and then Last_If (Idx) = First_If (Idx) + 1
+           and then No (Test (Last_If (Idx)))
+           and then No (Case_Expr (Idx)) and then No (Next (Idx))
+           and then (Target (First_If (Idx)) = Idx)
+                    /= (Target (Last_If (Idx)) = Idx);
+         --  True if the flow of this loop header is a rotated loop, whose
+         --  body is straight-line code ending with a test of whether to
+         --  repeat it, which we write as a "do" loop.
+
+         Outer_Loop : constant Flow_Idx := Current_Loop;
+         Was_Same   : Boolean           := False;
+         T          : Value_T;
 
       begin
          --  Get the terminator instruction, mark this flow as output,
@@ -1697,6 +1729,30 @@ package body CCG.Flow is
                          V           => Get_First_Instruction (BB (Idx)));
          end if;
 
+         --  If this is the header of a rotated loop, write its lines as
+         --  the body of a "do" loop whose condition is the test at the end.
+         --  Otherwise, if this is the header of a natural loop, write the
+         --  flow as the body of an infinite loop. We never fall off the end
+         --  of a flow written at the outermost level since nothing follows
+         --  it, so the loop only repeats where the flow branches back to
+         --  its start, which we write as a "continue". In both cases, the
+         --  label, if any, is in front of the loop, so a goto to it from
+         --  outside the loop (or from a nested loop) still has the same
+         --  effect.
+
+         if Is_Rotated then
+            Output_Stmt ("do",
+                         V         => Get_First_Instruction (BB (Idx)),
+                         Semicolon => False);
+            Start_Output_Block (Loop_Body);
+         elsif Is_Loop then
+            Output_Stmt ("for (;;)",
+                         V         => Get_First_Instruction (BB (Idx)),
+                         Semicolon => False);
+            Start_Output_Block (Loop_Body);
+            Current_Loop := Idx;
+         end if;
+
          --  Now process lines in the flow, if any
 
          if Present (First_Line (Idx)) then
@@ -1709,9 +1765,34 @@ package body CCG.Flow is
             end loop;
          end if;
 
+         --  For a rotated loop, the test of the flow is the condition of
+         --  the loop, negated if it's its "else" part that branches back,
+         --  and the other part is what follows the loop.
+
+         if Is_Rotated then
+            declare
+               Iidx  : constant If_Idx := First_If (Idx);
+               Cond  : constant Str    := Test (Iidx);
+               Again : constant Str    :=
+                 (if    Target (Iidx) = Idx then Cond
+                  elsif Needs_Parens (Cond, Unary) then "!(" & Cond & ")"
+                  else  "!" & Cond);
+
+            begin
+               Output_Stmt ("} while (" & Again & ")", V => Inst (Iidx));
+               End_Stmt_Block (Loop_Body);
+               Output_Flow_Target ((if   Target (Iidx) = Idx
+                                    then Target (Last_If (Idx))
+                                    else Target (Iidx)),
+                                   Inst (Iidx),
+                                   BS       => None,
+                                   Depth    => Depth,
+                                   Our_Next => Our_Next);
+            end;
+
          --  Next process any "if" parts in the flow
 
-         if Present (First_If (Idx)) then
+         elsif Present (First_If (Idx)) then
             for Iidx in First_If (Idx) .. Last_If (Idx) loop
                if Present (Test (Iidx)) then
                   Output_Stmt ((if Iidx = First_If (Idx) then "" else "else ")
@@ -1795,6 +1876,11 @@ package body CCG.Flow is
                                 Depth    => Depth,
                                 Our_Next => Our_Next);
          end if;
+
+         if Is_Loop and then not Is_Rotated then
+            End_Stmt_Block (Loop_Body);
+            Current_Loop := Outer_Loop;
+         end if;
       end Output_One_Flow;
 
    begin  -- Start of processing for Output_Flow
@@ -359,6 +359,11 @@ package body CCG.Subprograms is
 
       function In_Main_Unit return Boolean;
 
+      function Is_Pure_In_Ada return Boolean;
+      --  True if the front end allows calls to V to be omitted or combined,
+      --  either because of pragma Pure_Function or because V is declared
+      --  in a Pure unit (RM 10.2.1(18)).
+
       Num_Params     : constant Nat     := Count_Params (V);
       Fn_Typ         : constant Type_T  := Get_Element_Type (V);
       Write_Extern   : Boolean          := Need_Extern;
@@ -424,6 +429,19 @@ package body CCG.Subprograms is
            and then Entity_Is_In_Main_Unit (E);
       end In_Main_Unit;
 
+      --------------------
+      -- Is_Pure_In_Ada --
+      --------------------
+
+      function Is_Pure_In_Ada return Boolean is
+         E : constant Entity_Id := Get_Entity (V);
+
+      begin
+         return Present (E) and then Ekind (E) = E_Function
+           and then (Has_Pragma_Pure_Function (E)
+                     or else (Is_Pure (E) and then not Is_Imported (E)));
+      end Is_Pure_In_Ada;
+
    begin
       --  If this is an internal subprogram, mark it as static
 
@@ -471,6 +489,18 @@ package body CCG.Subprograms is
          Result := Output_Modifier ("noreturn") & Result;
       end if;
 
+      --  If Ada allows calls to this to be removed or combined and it only
+      --  reads memory and returns a value, say it's pure so the C compiler
+      --  can do that too. That LLVM inferred that a function only reads
+      --  memory isn't enough, since such a function may loop forever.
+
+      if Is_Pure_In_Ada and then Has_Readonly_Attribute (V)
+        and then not Does_Not_Return (V)
+        and then Get_Type_Kind (Get_Return_Type (Fn_Typ)) /= Void_Type_Kind
+      then
+         Result := Output_Modifier ("pure") & Result;
+      end if;
+
       --  Then output the list of parameter types, if any. If this isn't
       --  for an extern definition, include the parameter names.
       --  Special-case calloc since we can't tell that the integral type
@@ -501,6 +531,21 @@ package body CCG.Subprograms is
                   Typ := Type_Of (Param) + Need_Unsigned;
                end if;
 
+               --  If the object that a pointer parameter designates can't
+               --  be accessed through anything else, say so with restrict,
+               --  if the C version supports it. We don't make the object
+               --  const when the subprogram only reads it since we'd also
+               --  have to do so wherever we write the type of the function
+               --  and the parameter may be passed on to subprograms whose
+               --  parameters aren't const.
+
+               if Is_Pointer_Type (Param)
+                 and then Has_Noalias_Attribute (V, unsigned (J))
+                 and then C_Version >= 1999
+               then
+                  Typ := Typ & " restrict";
+               end if;
+
                --  Add this parameter to the list, usually preceeded by a comma
 
                Result := Result & (if J = 0 then "" else ", ") & Typ;
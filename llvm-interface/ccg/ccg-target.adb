@@ -433,6 +433,7 @@ package body CCG.Target is
            "declare-section-modifier=decl_sect;" &
            "modifier-decl_sect=#pragma section(%);" &
            "modifier-always_inline=$;" &
+           "modifier-pure=$;" &
            "modifier-noreturn=__declspec(noreturn);" &
            "modifier-aligned=__declspec(align(%));";
       elsif To_Lower (S) = "generic" then
@@ -440,6 +441,7 @@ package body CCG.Target is
            "packed-mechanism=none;" &
            "modifier-section=$;" &
            "modifier-always_inline=$;" &
+           "modifier-pure=$;" &
            "modifier-noreturn=$;" &
            "modifier-aligned=$;";
       else
@@ -19,6 +19,8 @@ with LLVM.Core; use LLVM.Core;
 
 with Ada.Strings.Fixed; use Ada.Strings.Fixed;
 
+with System.OS_Lib; use System.OS_Lib;
+
 with Get_Targ; use Get_Targ;
 
 with Atree;       use Atree;
@@ -114,8 +116,23 @@ package body CCG.Write is
    procedure Write_Source_Line (L : Physical_Line_Number);
    --  Write the Ada source line L from the main file
 
+   procedure Buffer_Output (S : String);
+   --  Special output procedure for the Output package while we're writing
+   --  the .c or .h file: append S to Out_Buffer, first writing out the
+   --  buffer if S doesn't fit.
+
+   procedure Flush_Out_Buffer;
+   --  Write the contents of Out_Buffer to the output file
+
    Octal : constant array (Integer range 0 .. 7) of Character := "01234567";
 
+   Out_Buffer             : String (1 .. 2 ** 16);
+   Out_Last               : Natural                    := 0;
+   --  The Output package writes each line as soon as it's complete, which
+   --  makes the number of system calls proportional to the number of lines
+   --  of C we generate. So we collect its output here and write it to the
+   --  file in large blocks.
+
    Main_Source_Name       : Str;
    --  If -gnatL is specifed, the fully-qualified filename of the main unit
 
@@ -969,6 +986,11 @@ package body CCG.Write is
          end if;
 
          Set_Output (Output_FD);
+         Out_Last := 0;
+
+         if Buffer_C_Output then
+            Set_Special_Output (Buffer_Output'Access);
+         end if;
       end if;
 
       --  If we're writing a header file, add test for file-specific symbol
@@ -1061,9 +1083,14 @@ package body CCG.Write is
          Write_Str ("#endif /* " & Defined_Name & "*/", Eol => True);
       end if;
 
-      --  If we opened a file to write to, close it
+      --  If we opened a file to write to, write out what we've buffered
+      --  and close it.
 
       if not Debug_Flag_Dot_YY then
+         Flush_Buffer;
+         Flush_Out_Buffer;
+         Cancel_Special_Output;
+
          if Emit_Header then
             Close_H_File;
          else
@@ -1076,6 +1103,41 @@ package body CCG.Write is
       pragma Assert (Indent = 0);
    end Finalize_Writing;
 
+   -------------------
+   -- Buffer_Output --
+   -------------------
+
+   procedure Buffer_Output (S : String) is
+   begin
+      --  The Output package never passes us more than its own buffer,
+      --  which is smaller than ours, so S always fits once we've flushed.
+
+      if Out_Last + S'Length > Out_Buffer'Last then
+         Flush_Out_Buffer;
+      end if;
+
+      Out_Buffer (Out_Last + 1 .. Out_Last + S'Length) := S;
+      Out_Last := Out_Last + S'Length;
+   end Buffer_Output;
+
+   ----------------------
+   -- Flush_Out_Buffer --
+   ----------------------
+
+   procedure Flush_Out_Buffer is
+   begin
+      if Out_Last > 0
+        and then Write (Output_FD, Out_Buffer'Address, Out_Last) /= Out_Last
+      then
+         Cancel_Special_Output;
+         Set_Standard_Error;
+         Write_Line ("fatal error: disk full");
+         OS_Exit (2);
+      end if;
+
+      Out_Last := 0;
+   end Flush_Out_Buffer;
+
    ---------------------
    -- Is_Comment_Line --
    ---------------------
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""Compare the runtime checks remaining in two builds of the same units.
+
+This reads the .checks.json files that llvm-gcc writes for each unit
+compiled with -fcheck-stats in two build directories, for example one
+where the units were compiled to objects and one where they were compiled
+to C with -c, and reports the subprograms in which the number of
+remaining checks of some kind differs between the two.  Each line gives
+the kind of check and the number remaining in the first and second
+builds, followed by the totals for all the units found in both.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+
+def read_dir(path):
+    """Return the remaining checks of each kind for each subprogram of the
+    units in PATH, indexed by unit name."""
+    units = {}
+    for entry in sorted(os.listdir(path)):
+        if entry.endswith(".checks.json"):
+            with open(os.path.join(path, entry)) as fd:
+                data = json.load(fd)
+            units[data["unit"]] = {
+                s["name"]: {c["kind"]: c["remaining"] for c in s["checks"]}
+                for s in data["subprograms"]}
+    return units
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare the runtime checks remaining in two builds.")
+    parser.add_argument("first", help="directory of the first build")
+    parser.add_argument("second", help="directory of the second build")
+    args = parser.parse_args()
+
+    first = read_dir(args.first)
+    second = read_dir(args.second)
+    common = sorted(set(first) & set(second))
+
+    for unit in sorted(set(first) ^ set(second)):
+        print("%s: only in %s" % (unit, args.first if unit in first
+                                  else args.second), file=sys.stderr)
+
+    if not common:
+        print("no units to compare", file=sys.stderr)
+        return 1
+
+    totals = {}
+    for unit in common:
+        subprograms = set(first[unit]) | set(second[unit])
+        for name in sorted(subprograms):
+            f = first[unit].get(name, {})
+            s = second[unit].get(name, {})
+            diffs = [(k, f.get(k, 0), s.get(k, 0))
+                     for k in sorted(set(f) | set(s))
+                     if f.get(k, 0) != s.get(k, 0)]
+            if diffs:
+                print("%s: %s" % (unit, name))
+                for kind, n1, n2 in diffs:
+                    print("    %-40s %6d %6d" % (kind, n1, n2))
+
+            for kind in set(f) | set(s):
+                t = totals.setdefault(kind, [0, 0])
+                t[0] += f.get(kind, 0)
+                t[1] += s.get(kind, 0)
+
+    print("total:")
+    for kind in sorted(totals):
+        print("    %-40s %6d %6d" % (kind, totals[kind][0], totals[kind][1]))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,515 @@
+/****************************************************************************
+ *                                                                          *
+ *                            GNAT-LLVM COMPONENTS                          *
+ *                                                                          *
+ *                        C O M P I L E _ S E R V E R                       *
+ *                                                                          *
+ *                          C Implementation File                           *
+ *                                                                          *
+ *                        Copyright (C) 2023, AdaCore                       *
+ *                                                                          *
+ * This is free software;  you can redistribute it  and/or modify it  under *
+ * terms of the  GNU General Public License as published  by the Free Soft- *
+ * ware  Foundation;  either version 3,  or (at your option) any later ver- *
+ * sion.  This software is distributed in the hope  that it will be useful, *
+ * but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- *
+ * TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public *
+ * License for  more details.  You should have  received  a copy of the GNU *
+ * General  Public  License  distributed  with  this  software;   see  file *
+ * COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy *
+ * of the license.                                                          *
+ *                                                                          *
+ ****************************************************************************/
+
+/* This file implements the compile server, which amortizes the startup cost
+   of the compiler (initializing LLVM for all targets and computing the C
+   type information of the target) over many compilations.
+
+   The GNAT front end isn't designed to compile more than one unit per
+   process, so the server is a fork server: it's started as
+   "llvm-gnat1 --compile-server=SOCKET", initializes LLVM during the
+   elaboration of GNATLLVM.Codegen and then waits for requests on the Unix
+   socket SOCKET.  For each request, it forks a process that takes over the
+   command line, environment, working directory and standard output and
+   error of the client and then continues elaborating and running the
+   compiler as if it had been started by the client.  Its exit status is
+   sent back to the client.
+
+   The client is llvm-gcc, which sends its compilations to the server named
+   by the GNAT_LLVM_COMPILE_SERVER environment variable instead of spawning
+   the compiler when that variable is set.
+
+   Since a request can make the server run arbitrary code (e.g. through
+   -fpass-plugin=), the socket is only accessible to the user running the
+   server and requests from processes of other users are rejected.
+
+   A request consists of a message carrying the client's standard output
+   and error file descriptors, followed by the working directory, the count
+   and values of the arguments, and the count and values of the environment
+   variables, each string preceded by its length.  The reply is the exit
+   status of the compilation.  */
+
+#ifndef _WIN32
+
+/* For struct ucred.  */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+/* Defined in the GNAT runtime and used by Ada.Command_Line.  */
+extern int gnat_argc;
+extern char **gnat_argv;
+extern char **gnat_envp;
+
+extern char **environ;
+
+/* Defined in llvm_wrapper.cc.  */
+extern void Initialize_LLVM (void);
+extern char *LLVMGetDefaultTargetTriple (void);
+extern void LLVMDisposeMessage (char *);
+extern void Warm_Target_C_Types (const char *, const char *, const char *,
+				 const char *);
+
+/* Write or read exactly LEN bytes of BUF on FD.  Return 0 on success.  */
+
+static int
+write_all (int fd, const void *buf, size_t len)
+{
+  const char *p = buf;
+
+  while (len > 0)
+    {
+      ssize_t n = write (fd, p, len);
+
+      if (n < 0 && errno == EINTR)
+	continue;
+      else if (n <= 0)
+	return -1;
+
+      p += n;
+      len -= n;
+    }
+
+  return 0;
+}
+
+static int
+read_all (int fd, void *buf, size_t len)
+{
+  char *p = buf;
+
+  while (len > 0)
+    {
+      ssize_t n = read (fd, p, len);
+
+      if (n < 0 && errno == EINTR)
+	continue;
+      else if (n <= 0)
+	return -1;
+
+      p += n;
+      len -= n;
+    }
+
+  return 0;
+}
+
+/* Send or receive a count or a length.  */
+
+static int
+send_u32 (int fd, uint32_t val)
+{
+  return write_all (fd, &val, sizeof val);
+}
+
+static int
+recv_u32 (int fd, uint32_t *val)
+{
+  return read_all (fd, val, sizeof *val);
+}
+
+/* Send or receive a string preceded by its length.  */
+
+static int
+send_string (int fd, const char *s)
+{
+  uint32_t len = strlen (s);
+
+  return send_u32 (fd, len) || write_all (fd, s, len);
+}
+
+static char *
+recv_string (int fd)
+{
+  uint32_t len;
+  char *s;
+
+  if (recv_u32 (fd, &len) || !(s = malloc (len + 1)))
+    return NULL;
+  else if (read_all (fd, s, len))
+    {
+      free (s);
+      return NULL;
+    }
+
+  s[len] = '\0';
+  return s;
+}
+
+/* Send or receive a vector of strings preceded by its length.  The
+   received vector is null-terminated.  */
+
+static int
+send_strings (int fd, int count, char **strings)
+{
+  int i;
+
+  if (send_u32 (fd, count))
+    return -1;
+
+  for (i = 0; i < count; i++)
+    if (send_string (fd, strings[i]))
+      return -1;
+
+  return 0;
+}
+
+static char **
+recv_strings (int fd, uint32_t *count)
+{
+  char **strings;
+  uint32_t i;
+
+  if (recv_u32 (fd, count)
+      || !(strings = calloc (*count + 1, sizeof (char *))))
+    return NULL;
+
+  for (i = 0; i < *count; i++)
+    if (!(strings[i] = recv_string (fd)))
+      return NULL;
+
+  return strings;
+}
+
+/* Send or receive the standard output and error file descriptors.  */
+
+static int
+send_fds (int sock, int fd_out, int fd_err)
+{
+  char byte = 0, control[CMSG_SPACE (2 * sizeof (int))];
+  struct iovec iov = {&byte, 1};
+  struct msghdr msg;
+  struct cmsghdr *cmsg;
+  int fds[2] = {fd_out, fd_err};
+
+  memset (&msg, 0, sizeof msg);
+  memset (control, 0, sizeof control);
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof control;
+  cmsg = CMSG_FIRSTHDR (&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN (sizeof fds);
+  memcpy (CMSG_DATA (cmsg), fds, sizeof fds);
+
+  return sendmsg (sock, &msg, 0) == 1 ? 0 : -1;
+}
+
+static int
+recv_fds (int sock, int *fd_out, int *fd_err)
+{
+  char byte, control[CMSG_SPACE (2 * sizeof (int))];
+  struct iovec iov = {&byte, 1};
+  struct msghdr msg;
+  struct cmsghdr *cmsg;
+  int fds[2];
+
+  memset (&msg, 0, sizeof msg);
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof control;
+
+  if (recvmsg (sock, &msg, 0) != 1
+      || !(cmsg = CMSG_FIRSTHDR (&msg))
+      || cmsg->cmsg_type != SCM_RIGHTS
+      || cmsg->cmsg_len != CMSG_LEN (sizeof fds))
+    return -1;
+
+  memcpy (fds, CMSG_DATA (cmsg), sizeof fds);
+  *fd_out = fds[0];
+  *fd_err = fds[1];
+  return 0;
+}
+
+/* Make a Unix socket address for PATH.  Return 0 on success.  */
+
+static int
+make_address (const char *path, struct sockaddr_un *addr)
+{
+  if (strlen (path) >= sizeof addr->sun_path)
+    return -1;
+
+  memset (addr, 0, sizeof *addr);
+  addr->sun_family = AF_UNIX;
+  strcpy (addr->sun_path, path);
+  return 0;
+}
+
+/* Return 0 if the process at the other end of CONN belongs to the user
+   running the server.  */
+
+static int
+check_peer (int conn)
+{
+#ifdef SO_PEERCRED
+  struct ucred cred;
+  socklen_t len = sizeof cred;
+
+  if (getsockopt (conn, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0
+      || len != sizeof cred)
+    return -1;
+
+  return cred.uid == geteuid () ? 0 : -1;
+#else
+  uid_t uid;
+  gid_t gid;
+
+  if (getpeereid (conn, &uid, &gid) != 0)
+    return -1;
+
+  return uid == geteuid () ? 0 : -1;
+#endif
+}
+
+/* Remove all the variables from our environment.  clearenv isn't available
+   on all the hosts we support, so unset them one by one.  */
+
+static void
+clear_environment (void)
+{
+  while (environ && environ[0])
+    {
+      const char *eq = strchr (environ[0], '=');
+      size_t len = eq ? (size_t) (eq - environ[0]) : strlen (environ[0]);
+      char *name = malloc (len + 1);
+
+      /* If we can't remove an entry, e.g. because its name is empty,
+	 drop the whole environment at once, which setenv and putenv
+	 accept.  */
+      if (!name)
+	{
+	  environ = NULL;
+	  return;
+	}
+
+      memcpy (name, environ[0], len);
+      name[len] = '\0';
+      if (unsetenv (name) != 0)
+	environ = NULL;
+
+      free (name);
+    }
+}
+
+/* Read a request from CONN and set up the current process to perform the
+   compilation it describes.  Return 0 on success.  */
+
+static int
+take_over_request (int conn)
+{
+  char *cwd, **args, **env;
+  uint32_t n_args, n_env, i;
+  int fd_out, fd_err;
+
+  if (recv_fds (conn, &fd_out, &fd_err)
+      || !(cwd = recv_string (conn))
+      || !(args = recv_strings (conn, &n_args))
+      || !(env = recv_strings (conn, &n_env))
+      || chdir (cwd) != 0)
+    return -1;
+
+  clear_environment ();
+  for (i = 0; i < n_env; i++)
+    putenv (env[i]);
+
+  dup2 (fd_out, 1);
+  dup2 (fd_err, 2);
+  close (fd_out);
+  close (fd_err);
+
+  /* Keep our own program name, since it's used to locate the runtime, but
+     take the client's arguments.  */
+  char **argv = calloc (n_args + 2, sizeof (char *));
+
+  if (!argv)
+    return -1;
+
+  argv[0] = gnat_argv[0];
+  memcpy (argv + 1, args, n_args * sizeof (char *));
+  gnat_argc = n_args + 1;
+  gnat_argv = argv;
+  gnat_envp = environ;
+  return 0;
+}
+
+/* Run the compile server on the Unix socket PATH.  This only returns in a
+   process that's to perform a compilation, in which case it returns 0, or
+   if the server couldn't be started, in which case it returns -1.  */
+
+int
+Run_Compile_Server (const char *path)
+{
+  struct sockaddr_un addr;
+  int sock, status;
+  mode_t old_mask;
+  char *triple;
+
+  /* Do the initializations whose cost we want to amortize.  Any
+     compilation for the default target and CPU will also reuse its C type
+     information.  */
+
+  Initialize_LLVM ();
+  triple = LLVMGetDefaultTargetTriple ();
+  Warm_Target_C_Types (triple, "generic", "", "");
+  LLVMDisposeMessage (triple);
+
+  if (make_address (path, &addr)
+      || (sock = socket (AF_UNIX, SOCK_STREAM, 0)) < 0)
+    return -1;
+
+  /* Create the socket with no access for others from the start, rather
+     than restricting it after the fact, so there's no window in which
+     another user can connect.  */
+
+  unlink (path);
+  old_mask = umask (077);
+  status = bind (sock, (struct sockaddr *) &addr, sizeof addr);
+  umask (old_mask);
+
+  if (status != 0
+      || chmod (path, S_IRUSR | S_IWUSR) != 0
+      || listen (sock, SOMAXCONN) != 0)
+    return -1;
+
+  /* We never wait for the processes that handle requests.  */
+  signal (SIGCHLD, SIG_IGN);
+
+  for (;;)
+    {
+      int conn = accept (sock, NULL, NULL);
+
+      if (conn < 0)
+	continue;
+      else if (check_peer (conn) != 0)
+	{
+	  close (conn);
+	  continue;
+	}
+
+      /* Handle each request in a child so that the server never waits for
+	 a client.  The child forks the process that does the compilation,
+	 waits for it and sends its status back.  */
+
+      if (fork () == 0)
+	{
+	  pid_t pid;
+	  int status;
+	  int32_t result;
+
+	  close (sock);
+	  signal (SIGCHLD, SIG_DFL);
+
+	  pid = fork ();
+	  if (pid == 0)
+	    {
+	      if (take_over_request (conn) != 0)
+		_exit (4);
+
+	      close (conn);
+	      return 0;
+	    }
+
+	  while (pid > 0 && waitpid (pid, &status, 0) < 0 && errno == EINTR)
+	    ;
+
+	  result = (pid < 0 ? 4
+		    : WIFEXITED (status) ? WEXITSTATUS (status)
+		    : 128 + WTERMSIG (status));
+	  write_all (conn, &result, sizeof result);
+	  _exit (0);
+	}
+
+      close (conn);
+    }
+}
+
+/* Have the compile server on the Unix socket PATH perform the compilation
+   with the ARGC arguments ARGV.  Return the exit status of the compilation
+   or -1 if the server couldn't be reached.  */
+
+int
+Compile_Client (const char *path, int argc, char **argv)
+{
+  struct sockaddr_un addr;
+  char cwd[4096];
+  int sock, env_count = 0;
+  int32_t result;
+
+  if (make_address (path, &addr)
+      || !getcwd (cwd, sizeof cwd)
+      || (sock = socket (AF_UNIX, SOCK_STREAM, 0)) < 0)
+    return -1;
+
+  if (connect (sock, (struct sockaddr *) &addr, sizeof addr) != 0)
+    {
+      close (sock);
+      return -1;
+    }
+
+  while (environ[env_count])
+    env_count++;
+
+  if (send_fds (sock, 1, 2)
+      || send_string (sock, cwd)
+      || send_strings (sock, argc, argv)
+      || send_strings (sock, env_count, environ)
+      || read_all (sock, &result, sizeof result))
+    result = -1;
+
+  close (sock);
+  return result;
+}
+
+#else
+
+/* There are no Unix sockets on Windows, so there's no compile server
+   either and we always spawn the compiler.  */
+
+int
+Run_Compile_Server (const char *path)
+{
+  return -1;
+}
+
+int
+Compile_Client (const char *path, int argc, char **argv)
+{
+  return -1;
+}
+
+#endif
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""Measure what the compile server saves on a set of compilations.
+
+This compiles each of the given Ada sources with llvm-gcc -c, once with
+the compiler started for each unit as usual and once through a compile
+server started for the run with "llvm-gnat1 --compile-server=SOCKET" and
+named to llvm-gcc by GNAT_LLVM_COMPILE_SERVER.  Each compilation is
+repeated --runs times in each mode and the best wall-clock time is kept.
+We report the time of each unit in both modes and the total, which
+includes the time to start the server.
+
+Extra switches for llvm-gcc can be given after "--", for example
+"-- -O2 -gnatp".  The objects are written to a temporary directory.
+"""
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def compile_unit(gcc, source, switches, outdir, env):
+    """Compile SOURCE with GCC and return the wall-clock time it took."""
+    obj = os.path.join(outdir,
+                       os.path.splitext(os.path.basename(source))[0] + ".o")
+    start = time.monotonic()
+    subprocess.run([gcc, "-c", source, "-o", obj] + switches, env=env,
+                   check=True)
+    return time.monotonic() - start
+
+
+def best_time(runs, *args):
+    return min(compile_unit(*args) for _ in range(runs))
+
+
+def wait_for_socket(path, server, timeout=30.0):
+    """Wait until the server has created the socket PATH."""
+    deadline = time.monotonic() + timeout
+    while not os.path.exists(path):
+        if server.poll() is not None:
+            sys.exit("compile server exited with status %d"
+                     % server.returncode)
+        if time.monotonic() > deadline:
+            sys.exit("compile server didn't start")
+        time.sleep(0.01)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Measure what the compile server saves.")
+    parser.add_argument("--gcc", default="llvm-gcc",
+                        help="driver to use (default llvm-gcc)")
+    parser.add_argument("--gnat1", default="llvm-gnat1",
+                        help="compiler to start as server "
+                        "(default llvm-gnat1)")
+    parser.add_argument("--runs", type=int, default=3,
+                        help="number of times to compile each unit")
+    parser.add_argument("sources", nargs="+", help="Ada sources to compile")
+    argv = sys.argv[1:]
+    switches = []
+    if "--" in argv:
+        switches = argv[argv.index("--") + 1:]
+        argv = argv[:argv.index("--")]
+    args = parser.parse_args(argv)
+
+    tmpdir = tempfile.mkdtemp(prefix="compile-server-")
+    socket = os.path.join(tmpdir, "socket")
+    env = dict(os.environ)
+    env.pop("GNAT_LLVM_COMPILE_SERVER", None)
+    server_env = dict(env, GNAT_LLVM_COMPILE_SERVER=socket)
+
+    try:
+        start = time.monotonic()
+        direct = [best_time(args.runs, args.gcc, s, switches, tmpdir, env)
+                  for s in args.sources]
+        direct_total = time.monotonic() - start
+
+        start = time.monotonic()
+        server = subprocess.Popen([args.gnat1, "--compile-server=" + socket])
+        try:
+            wait_for_socket(socket, server)
+            served = [best_time(args.runs, args.gcc, s, switches, tmpdir,
+                                server_env)
+                      for s in args.sources]
+        finally:
+            server.terminate()
+            server.wait()
+        served_total = time.monotonic() - start
+    finally:
+        shutil.rmtree(tmpdir)
+
+    print("%-40s %10s %10s %7s" % ("unit", "direct", "server", "saved"))
+    for source, d, s in zip(args.sources, direct, served):
+        print("%-40s %9.3fs %9.3fs %6.1f%%"
+              % (os.path.basename(source), d, s, 100.0 * (d - s) / d))
+    print("%-40s %9.3fs %9.3fs %6.1f%%"
+          % ("total (%d runs)" % args.runs, direct_total, served_total,
+             100.0 * (direct_total - served_total) / direct_total))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+"""Compare the object size and link time of each kind of debug info.
+
+This generates a program of --units packages, each declaring a few record
+and array types and a function that uses them, and a function that calls
+all of those.  The program is compiled by llvm-gcc with no debug info,
+with -gline-tables-only, with -g and with -g -gsplit-dwarf, and each build
+is linked with ccg-bench/bench_main.c and run once to check its result.
+
+For each build, we report the time to compile all the units, the total
+size of the object files and of the .dwo files next to them, and the
+shortest of --links links of the program, followed by the ratio of the
+sizes and link time to those of the -g build.  The exit status is nonzero
+if a build or a result is wrong.
+"""
+
+import argparse
+import glob
+import os
+import shlex
+import subprocess
+import sys
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+M64 = (1 << 64) - 1
+
+MODES = {
+    "none": [],
+    "line-tables": ["-gline-tables-only"],
+    "full": ["-g"],
+    "split": ["-g", "-gsplit-dwarf"],
+}
+
+
+def write_sources(wdir, units):
+    """Write the program described above, with UNITS packages, to WDIR and
+    return the names of the bodies to compile."""
+    bodies = []
+    for k in range(1, units + 1):
+        with open(os.path.join(wdir, "unit_%d.ads" % k), "w") as fd:
+            fd.write("""with Interfaces; use Interfaces;
+
+package Unit_{0} is
+   type Rec_{0} is record
+      A : Integer;
+      B : Long_Float;
+      C : String (1 .. 8);
+   end record;
+
+   type Arr_{0} is array (1 .. 16) of Rec_{0};
+
+   function Run_{0} (Scale : Integer) return Unsigned_64;
+end Unit_{0};
+""".format(k))
+
+        with open(os.path.join(wdir, "unit_%d.adb" % k), "w") as fd:
+            fd.write("""package body Unit_{0} is
+   function Run_{0} (Scale : Integer) return Unsigned_64 is
+      R   : Arr_{0};
+      Sum : Unsigned_64 := {0};
+
+   begin
+      for J in R'Range loop
+         R (J) := (A => Scale + J * {0}, B => Long_Float (J),
+                   C => (others => Character'Val (J + 64)));
+      end loop;
+
+      for J in R'Range loop
+         Sum := Sum * 31 + Unsigned_64 (R (J).A);
+      end loop;
+
+      return Sum;
+   end Run_{0};
+end Unit_{0};
+""".format(k))
+        bodies.append("unit_%d.adb" % k)
+
+    with open(os.path.join(wdir, "debug_kernel.adb"), "w") as fd:
+        fd.write("".join("with Unit_%d;\n" % k for k in range(1, units + 1)))
+        fd.write("""with Interfaces; use Interfaces;
+
+function Debug_Kernel (Scale : Integer) return Unsigned_64
+  with Export, Convention => C, External_Name => "kernel_run"
+is
+   Result : Unsigned_64 := 0;
+
+begin
+""")
+        for k in range(1, units + 1):
+            fd.write("   Result := Result * 31 + Unit_%d.Run_%d (Scale);\n"
+                     % (k, k))
+        fd.write("""   return Result;
+end Debug_Kernel;
+""")
+    bodies.append("debug_kernel.adb")
+    return bodies
+
+
+def oracle(units, scale):
+    """What the program returns for SCALE."""
+    result = 0
+    for k in range(1, units + 1):
+        total = k
+        for j in range(1, 17):
+            total = (total * 31 + scale + j * k) & M64
+        result = (result * 31 + total) & M64
+    return result
+
+
+def run(cmd, cwd, log):
+    """Run CMD in CWD, appending its output to LOG, and return whether it
+    succeeded."""
+    with open(log, "a") as fd:
+        fd.write("$ %s\n" % " ".join(shlex.quote(c) for c in cmd))
+        fd.flush()
+        return subprocess.run(cmd, cwd=cwd, stdout=fd,
+                              stderr=subprocess.STDOUT).returncode == 0
+
+
+def total_size(pattern):
+    """Return the total size of the files matching PATTERN."""
+    return sum(os.path.getsize(f) for f in glob.glob(pattern))
+
+
+def build_and_link(args, mode, expected):
+    """Build the program in a subdirectory MODE of the build directory and
+    return the compile time, the sizes of the object and .dwo files and the
+    best link time, or None if that failed."""
+    wdir = os.path.join(args.build_dir, mode)
+    log = os.path.join(wdir, "build.log")
+    os.makedirs(wdir, exist_ok=True)
+    for f in glob.glob(os.path.join(wdir, "*")):
+        os.remove(f)
+
+    bodies = write_sources(wdir, args.units)
+    start = time.monotonic()
+    for body in bodies:
+        if not run([args.gcc, "-c"] + args.adaflags + MODES[mode] + [body],
+                   wdir, log):
+            print("%s build failed, see %s" % (mode, log), file=sys.stderr)
+            return None
+    compile_time = time.monotonic() - start
+
+    if not run([args.cc, "-O2", "-c", "-o", "bench_main.o",
+                os.path.join(HERE, "ccg-bench", "bench_main.c")], wdir, log):
+        print("%s build failed, see %s" % (mode, log), file=sys.stderr)
+        return None
+
+    link = ([args.cc] + args.ldflags + ["-o", "bench", "bench_main.o"]
+            + [b.replace(".adb", ".o") for b in bodies]
+            + [os.path.join(args.adalib, "libgnat.a"), "-lm", "-lpthread",
+               "-ldl"])
+    link_time = None
+    for _ in range(args.links):
+        start = time.monotonic()
+        if not run(link, wdir, log):
+            print("%s link failed, see %s" % (mode, log), file=sys.stderr)
+            return None
+        elapsed = time.monotonic() - start
+        link_time = elapsed if link_time is None else min(link_time, elapsed)
+
+    res = subprocess.run([os.path.join(wdir, "bench"), str(args.scale), "1",
+                          str(expected)], capture_output=True, text=True)
+    if res.returncode != 0:
+        print("%s: %s" % (mode, res.stderr.strip()), file=sys.stderr)
+        return None
+
+    return (compile_time, total_size(os.path.join(wdir, "*.o")),
+            total_size(os.path.join(wdir, "*.dwo")), link_time)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare the object size and link time of each kind of "
+        "debug info.")
+    parser.add_argument("--gcc", default=os.path.join(HERE, "bin", "llvm-gcc"),
+                        help="llvm-gcc to measure")
+    parser.add_argument("--cc", default="cc",
+                        help="host C compiler, also used to link")
+    parser.add_argument("--adalib",
+                        default=os.path.join(HERE, "lib", "rts-native",
+                                             "adalib"),
+                        help="directory of the libgnat.a to link with")
+    parser.add_argument("--adaflags", default="-O2",
+                        help="switches for llvm-gcc (default -O2)")
+    parser.add_argument("--ldflags", default="",
+                        help="switches for the link, for example "
+                        "-fuse-ld=lld")
+    parser.add_argument("--units", type=int, default=200,
+                        help="number of packages in the program "
+                        "(default 200)")
+    parser.add_argument("--scale", type=int, default=12345,
+                        help="parameter of the program (default 12345)")
+    parser.add_argument("--links", type=int, default=5,
+                        help="number of links of each build (default 5)")
+    parser.add_argument("--build-dir", default="debuginfo-bench-build",
+                        help="directory for the builds")
+    args = parser.parse_args()
+    args.adaflags = shlex.split(args.adaflags)
+    args.ldflags = shlex.split(args.ldflags)
+    args.build_dir = os.path.abspath(args.build_dir)
+
+    expected = oracle(args.units, args.scale)
+    results = {}
+    for mode in MODES:
+        results[mode] = build_and_link(args, mode, expected)
+    if None in results.values():
+        return 1
+
+    _, full_obj, _, full_link = results["full"]
+    print("%-12s %10s %12s %12s %10s %8s %8s"
+          % ("", "compile", "objects", ".dwo", "link", "objects", "link"))
+    for mode, (compile_time, obj, dwo, link) in results.items():
+        print("%-12s %9.2fs %12d %12d %8.1fms %8.2f %8.2f"
+              % (mode, compile_time, obj, dwo, link * 1e3, obj / full_obj,
+                 link / full_link))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
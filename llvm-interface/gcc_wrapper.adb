@@ -29,6 +29,8 @@ with Ada.Text_IO;             use Ada.Text_IO;
 with Ada.Command_Line;        use Ada.Command_Line;
 with Ada.Strings.Fixed;       use Ada.Strings.Fixed;
 with GNAT.OS_Lib;             use GNAT.OS_Lib;
+with Interfaces.C;            use Interfaces.C;
+with Interfaces.C.Strings;    use Interfaces.C.Strings;
 
 with LLVM.Target_Machine; use LLVM.Target_Machine;
 
@@ -65,7 +67,7 @@ procedure GCC_Wrapper is
    --  is a Clang instance that we expect to be on the PATH, like GNAT-LLVM C.
 
    GCC                  : constant String := Command_Name;
-   Args                 : Argument_List (1 .. Argument_Count + 1);
+   Args                 : Argument_List (1 .. Argument_Count + 2);
    Arg_Count            : Natural := 0;
    Status               : Boolean;
    Last                 : Natural;
@@ -77,11 +79,20 @@ procedure GCC_Wrapper is
    Dash_Wall_Index      : Natural := 0;
    Dump_SCOs_Index      : Natural := 0;
    Static_Libasan_Index : Natural := 0;
+   LTO_Cache_Index      : Natural := 0;
+   LTO                  : Boolean := False;
+   Fuse_Ld              : Boolean := False;
    S                    : String_Access;
 
    procedure Spawn (S : String; Args : Argument_List; Status : out Boolean);
    --  Call GNAT.OS_Lib.Spawn and take Verbose into account
 
+   function Compile_On_Server
+     (Socket : String; Args : Argument_List) return Integer;
+   --  Have the compile server listening on the Unix socket Socket run the
+   --  compiler with Args. Return the exit status of the compiler or -1 if
+   --  the server couldn't be reached.
+
    function Executable_Location return String;
    --  Return the name of the parent directory where the executable is stored
    --  (so if you are running "prefix"/bin/gcc, you would get "prefix").
@@ -111,6 +122,44 @@ procedure GCC_Wrapper is
       GNAT.OS_Lib.Spawn (S, Args, Status);
    end Spawn;
 
+   -----------------------
+   -- Compile_On_Server --
+   -----------------------
+
+   function Compile_On_Server
+     (Socket : String; Args : Argument_List) return Integer
+   is
+      function Compile_Client
+        (Socket : String; Argc : int; Argv : chars_ptr_array) return int
+        with Import, Convention => C, External_Name => "Compile_Client";
+
+      C_Args : chars_ptr_array (1 .. size_t (Args'Length));
+      Result : int;
+
+   begin
+      for J in Args'Range loop
+         C_Args (size_t (J - Args'First + 1)) := New_String (Args (J).all);
+      end loop;
+
+      if Verbose then
+         Put ("compile server " & Socket & ":");
+
+         for J in Args'Range loop
+            Put (" " & Args (J).all);
+         end loop;
+
+         New_Line;
+      end if;
+
+      Result := Compile_Client (Socket & ASCII.NUL, Args'Length, C_Args);
+
+      for J in C_Args'Range loop
+         Free (C_Args (J));
+      end loop;
+
+      return Integer (Result);
+   end Compile_On_Server;
+
    -------------------------
    -- Executable_Location --
    -------------------------
@@ -362,6 +411,24 @@ begin
          elsif Arg = "-static-libasan" then
             Static_Libasan_Index := Arg_Count + 1;
 
+         --  Recognize the link-time optimization switches, which need
+         --  special handling when linking.
+
+         elsif Arg = "-flto"
+           or else (Arg'Length > 6 and then Arg (1 .. 6) = "-flto=")
+         then
+            LTO := True;
+
+         elsif Arg = "-fno-lto" then
+            LTO := False;
+
+         elsif Arg'Length > 16 and then Arg (1 .. 16) = "-flto-cache-dir="
+         then
+            LTO_Cache_Index := Arg_Count + 1;
+
+         elsif Arg'Length > 9 and then Arg (1 .. 9) = "-fuse-ld=" then
+            Fuse_Ld := True;
+
          elsif Arg = "-v" then
             Verbose := True;
             Skip := True;
@@ -416,6 +483,31 @@ begin
       Args (Static_Libasan_Index) := new String'("-static-libsan");
    end if;
 
+   --  When linking, replace -flto-cache-dir= by the switch that tells the
+   --  linker where to cache the native objects it generates during
+   --  ThinLTO.
+
+   if LTO_Cache_Index /= 0 and then not Compile then
+      declare
+         Switch : constant String := Args (LTO_Cache_Index).all;
+      begin
+         Free (Args (LTO_Cache_Index));
+         Args (LTO_Cache_Index) :=
+           new String'("-Wl,--thinlto-cache-dir=" &
+                       Switch (17 .. Switch'Last));
+      end;
+   end if;
+
+   --  When linking with link-time optimization, use lld unless another
+   --  linker was requested: it performs the thin link, imports across
+   --  units and generates code for each module in parallel by itself,
+   --  while other linkers would need a plugin.
+
+   if LTO and then not Compile and then not Fuse_Ld then
+      Arg_Count        := Arg_Count + 1;
+      Args (Arg_Count) := new String'("-fuse-ld=lld");
+   end if;
+
    if GCC'Length >= 3
      and then GCC (GCC'Last - 2 .. GCC'Last) = "gcc"
    then
@@ -486,7 +578,28 @@ begin
 
          --  ??? delete previous .o file
 
-         Spawn (S.all, Args (1 .. Arg_Count), Status);
+         --  If a compile server is running, have it do the compilation,
+         --  which saves the startup cost of the compiler. Fall back to
+         --  running the compiler ourselves if it can't be reached.
+
+         declare
+            Server : String_Access := Getenv ("GNAT_LLVM_COMPILE_SERVER");
+            Result : Integer       := -1;
+
+         begin
+            if Server.all /= "" then
+               Result := Compile_On_Server (Server.all, Args (1 .. Arg_Count));
+            end if;
+
+            if Result >= 0 then
+               Status := Result = 0;
+            else
+               Spawn (S.all, Args (1 .. Arg_Count), Status);
+            end if;
+
+            Free (Server);
+         end;
+
          Free (S);
       end;
    else
@@ -27,7 +27,6 @@ with GNATLLVM.DebugInfo;     use GNATLLVM.DebugInfo;
 with GNATLLVM.Exprs;         use GNATLLVM.Exprs;
 with GNATLLVM.Instructions;  use GNATLLVM.Instructions;
 with GNATLLVM.Records;       use GNATLLVM.Records;
-with GNATLLVM.Utils;         use GNATLLVM.Utils;
 with GNATLLVM.Variables;     use GNATLLVM.Variables;
 
 package body GNATLLVM.Arrays is
@@ -68,6 +67,20 @@ package body GNATLLVM.Arrays is
    --  remaining. Return an LLVM constant including all of the constants
    --  in that aggregate.
 
+   procedure Copy_Constant_Sub_Aggregate
+     (LHS       : GL_Value;
+      Idxs      : GL_Value_Array;
+      N         : N_Subexpr_Id;
+      Comp_Type : GL_Type;
+      Dims_Left : Nat)
+     with Pre => Is_Reference (LHS) and then Is_No_Elab_Needed (N)
+                 and then Nkind (N) in N_Aggregate | N_Extension_Aggregate
+                 and then Present (Comp_Type) and then Dims_Left > 0;
+   --  N is a constant aggregate for the part of the multi-dimensional
+   --  array LHS that's indexed by Idxs and has Dims_Left dimensions
+   --  remaining. Rather than storing each component of that part, make a
+   --  constant global for it and copy it into LHS.
+
    function Swap_Indices
      (Idxs : GL_Value_Array; V : GL_Value) return GL_Value_Array
      with Pre  => Is_Array_Type (Related_Type (V)),
@@ -1054,6 +1067,38 @@ package body GNATLLVM.Arrays is
 
    end Emit_Constant_Aggregate;
 
+   ---------------------------------
+   -- Copy_Constant_Sub_Aggregate --
+   ---------------------------------
+
+   procedure Copy_Constant_Sub_Aggregate
+     (LHS       : GL_Value;
+      Idxs      : GL_Value_Array;
+      N         : N_Subexpr_Id;
+      Comp_Type : GL_Type;
+      Dims_Left : Nat)
+   is
+      Zeros : constant GL_Value_Array (1 .. Dims_Left) :=
+        (others => Size_Const_Null);
+      Val   : constant GL_Value                        :=
+        Emit_Constant_Aggregate (N, Comp_Type, Any_Array_GL_Type, Dims_Left);
+      Align : constant ULL                             :=
+        To_Bytes (Get_Type_Alignment (Comp_Type));
+      Size  : constant GL_Value                        :=
+        Size_Const_Int (To_Bytes (ULL'(Get_Type_Size (Type_Of (Val)))));
+
+   begin
+      --  The part of LHS we're initializing starts at the component whose
+      --  remaining indices are all zero and, since it's laid out in row
+      --  major order, is contiguous.
+
+      Build_MemCpy (Pointer_Cast (Get_Indexed_LValue (Idxs & Zeros, LHS),
+                                  A_Char_GL_Type),
+                    Align,
+                    Pointer_Cast (Make_Global_Constant (Val), A_Char_GL_Type),
+                    Align, Size, Is_Volatile (LHS));
+   end Copy_Constant_Sub_Aggregate;
+
    ------------------
    -- Swap_Indices --
    ------------------
@@ -1159,6 +1204,20 @@ package body GNATLLVM.Arrays is
                if Decls_Only then
                   Discard (Emit_Expression (Expr));
 
+               --  If this is a nested N_Aggregate whose components are all
+               --  constants and we're filling in memory, copy it from a
+               --  constant global instead of storing each component. We
+               --  can't do this for a Fortran array, which isn't laid out
+               --  in row major order.
+
+               elsif Nkind (Expr) in N_Aggregate | N_Extension_Aggregate
+                 and then Dims_Left > 1 and then not Is_Data (Cur_Value)
+                 and then Is_No_Elab_Needed (Expr)
+                 and then Convention (GT) /= Convention_Fortran
+               then
+                  Copy_Constant_Sub_Aggregate (Cur_Value, Idxs, Expr, Comp_GT,
+                                               Dims_Left - 1);
+
                --  If this is a nested N_Aggregate and we have dimensions
                --  left in the outer array, use recursion to fill in the
                --  aggregate.
@@ -1656,4 +1715,47 @@ package body GNATLLVM.Arrays is
       end if;
    end Build_Indexed_Store;
 
+   ------------------
+   -- Vector_Lanes --
+   ------------------
+
+   function Vector_Lanes (GT : GL_Type) return Nat is
+      T      : constant Type_T := Type_Of (GT);
+      Elmt_T : Type_T;
+
+   begin
+      --  We need a native, one-dimensional array whose LLVM type is an
+      --  array of integer or floating-point components. This excludes
+      --  packed array implementation types and components with a size
+      --  clause that makes them padded.
+
+      if not Is_Array_Type (GT) or else Is_Nonnative_Type (GT)
+        or else Number_Dimensions (GT) /= 1
+        or else Get_Type_Kind (T) /= Array_Type_Kind
+        or else Get_Array_Length (T) = 0
+        or else Has_Biased_Representation (Full_Etype (GT))
+      then
+         return 0;
+      end if;
+
+      --  The components must be of a type that's packed the same way in
+      --  a vector and an array, which isn't the case of integers that
+      --  aren't a power-of-two number of bytes or of x86 long double.
+
+      Elmt_T := Get_Element_Type (T);
+
+      if (Is_Integer_Type (Full_Component_Type (GT))
+            and then Get_Type_Kind (Elmt_T) = Integer_Type_Kind
+            and then Get_Int_Type_Width (Elmt_T) in 8 | 16 | 32 | 64)
+        or else (Is_Floating_Point_Type (Full_Component_Type (GT))
+                   and then Get_Type_Kind (Elmt_T) in
+                              Half_Type_Kind | B_Float_Type_Kind |
+                              Float_Type_Kind | Double_Type_Kind)
+      then
+         return Nat (Get_Array_Length (T));
+      else
+         return 0;
+      end if;
+   end Vector_Lanes;
+
 end GNATLLVM.Arrays;
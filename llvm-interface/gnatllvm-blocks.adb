@@ -36,6 +36,7 @@ with GNATLLVM.Compile;      use GNATLLVM.Compile;
 with GNATLLVM.Environment;  use GNATLLVM.Environment;
 with GNATLLVM.GLType;       use GNATLLVM.GLType;
 with GNATLLVM.Instructions; use GNATLLVM.Instructions;
+with GNATLLVM.Proofs;       use GNATLLVM.Proofs;
 with GNATLLVM.Types;        use GNATLLVM.Types;
 with GNATLLVM.Utils;        use GNATLLVM.Utils;
 with GNATLLVM.Variables;    use GNATLLVM.Variables;
@@ -335,6 +336,12 @@ package body GNATLLVM.Blocks is
    --  Get function for raising a builtin exception of Kind. Ext is True if
    --  we want the "extended" (-gnateE) versions of the exception functions.
 
+   procedure Finish_Raise_Block (BB : Basic_Block_T; Kind : RT_Exception_Code)
+     with Pre => Present (BB);
+   --  BB ends with the call we just made to raise the exception for a
+   --  failed check of Kind: make it cold and, if we're asked for check
+   --  statistics, tag it with the name of Kind.
+
    function Emit_Raise_Call_With_Extra_Info
      (N    : N_Raise_xxx_Error_Id;
       Kind : RT_Exception_Code;
@@ -841,10 +848,19 @@ package body GNATLLVM.Blocks is
       N    : Node_Id;
       Kind : RT_Exception_Code := CE_Overflow_Check_Failed)
    is
-      BB_Then  : constant Basic_Block_T := Create_Basic_Block ("RAISE");
-      BB_Next  : constant Basic_Block_T := Create_Basic_Block;
+      BB_Then  : Basic_Block_T;
+      BB_Next  : Basic_Block_T;
 
    begin
+      --  If gnatprove proved that the check can never fail, we needn't
+      --  test for it.
+
+      if Is_Proved (N, Kind) then
+         return;
+      end if;
+
+      BB_Then := Create_Basic_Block ("RAISE");
+      BB_Next := Create_Basic_Block;
       Build_Cond_Br (V, BB_Then, BB_Next);
       Position_Builder_At_End (BB_Then);
       Emit_Raise_Call (N, Kind);
@@ -924,16 +940,17 @@ package body GNATLLVM.Blocks is
    procedure Emit_Raise_Call
      (N : Node_Id; Kind : RT_Exception_Code; Column : Boolean := False)
    is
-      S    : constant Source_Ptr := Sloc (N);
-      File : constant GL_Value   :=
+      S    : constant Source_Ptr    := Sloc (N);
+      File : constant GL_Value      :=
         Get_File_Name_Address (Get_Source_File_Index (S));
-      Line : constant GL_Value   :=
+      Line : constant GL_Value      :=
         Const_Int (Integer_GL_Type,
                    ULL (if   Debug_Flag_NN
                              or else Exception_Locations_Suppressed
                         then 0 else Get_Logical_Line_Number (S)));
-      Col  : constant GL_Value   :=
+      Col  : constant GL_Value      :=
         Const_Int (Integer_GL_Type, ULL (Get_Column_Number (S)));
+      BB   : constant Basic_Block_T := Get_Insert_Block;
 
    begin
       --  Build a call to __gnat_xx (FILE, LINE)
@@ -944,8 +961,34 @@ package body GNATLLVM.Blocks is
       else
          Call (Get_Raise_Fn (Kind), (1 => File, 2 => Line));
       end if;
+
+      Finish_Raise_Block (BB, Kind);
    end Emit_Raise_Call;
 
+   ------------------------
+   -- Finish_Raise_Block --
+   ------------------------
+
+   procedure Finish_Raise_Block (BB : Basic_Block_T; Kind : RT_Exception_Code)
+   is
+   begin
+      --  A check failing is the unlikely case, so keep the raise out of
+      --  the way of the code that follows a successful check.
+
+      if Cold_Checks then
+         Mark_Raise_Block_Cold (BB);
+      end if;
+
+      --  Name the kind of the check after its exception code, as for the
+      --  raise function.
+
+      if Check_Stats then
+         Name_Len := 0;
+         Get_RT_Exception_Name (Kind);
+         Set_Check_Kind (BB, Name_Buffer (1 .. Name_Len));
+      end if;
+   end Finish_Raise_Block;
+
    ---------------------
    -- Emit_Raise_Call --
    ---------------------
@@ -970,6 +1013,7 @@ package body GNATLLVM.Blocks is
       Index  : GL_Value;
       LB_V   : GL_Value;
       HB_V   : GL_Value;
+      BB     : Basic_Block_T;
 
    begin
       --  If this isn't a NOT operation, we can't handle it. If we're only
@@ -1019,9 +1063,11 @@ package body GNATLLVM.Blocks is
                                    Integer_GL_Type);
       LB_V  := Emit_Convert_Value (LB, Integer_GL_Type);
       HB_V  := Emit_Convert_Value (HB, Integer_GL_Type);
+      BB    := Get_Insert_Block;
       Call (Get_Raise_Fn (Kind, Ext => True),
             (1 => File,  2 => Line, 3 => Col,
              4 => Index, 5 => LB_V, 6 => HB_V));
+      Finish_Raise_Block (BB, Kind);
       return True;
 
    end Emit_Raise_Call_With_Extra_Info;
@@ -23,6 +23,7 @@ with Sem_Eval;    use Sem_Eval;
 with Sem_Util;    use Sem_Util;
 with Stand;       use Stand;
 
+with GNATLLVM.Arrays;       use GNATLLVM.Arrays;
 with GNATLLVM.Codegen;      use GNATLLVM.Codegen;
 with GNATLLVM.Compile;      use GNATLLVM.Compile;
 with GNATLLVM.Conditionals; use GNATLLVM.Conditionals;
@@ -148,6 +149,12 @@ package body GNATLLVM.Builtins is
      (N : N_Subprogram_Call_Id; S : String) return GL_Value;
    --  Generate a call to the an __atomic builtin if valid
 
+   function Emit_Vector_Call
+     (N : N_Subprogram_Call_Id; S : String) return GL_Value;
+   --  If S is the name, without the __builtin_vector_ prefix, of a vector
+   --  builtin and the operands of N are valid for it, generate it.
+   --  Otherwise, return No_GL_Value.
+
    function Get_Default_Alloc_Fn_Name return String is
      ((if   Emit_C and then not Use_GNAT_Allocs
        then "malloc" else "__gnat_malloc"));
@@ -1274,6 +1281,589 @@ package body GNATLLVM.Builtins is
 
    end Emit_FP_Isinf_Call;
 
+   ----------------------
+   -- Emit_Vector_Call --
+   ----------------------
+
+   function Emit_Vector_Call
+     (N : N_Subprogram_Call_Id; S : String) return GL_Value
+   is
+      Reduce   : constant Boolean          :=
+        S'Length > 7 and then S (S'First .. S'First + 6) = "reduce_";
+      Op       : constant String           :=
+        (if Reduce then S (S'First + 7 .. S'Last) else S);
+      Num_Args : constant Nat              := Num_Actuals (N);
+      Is_Func  : constant Boolean          := Nkind (N) = N_Function_Call;
+      Arg1     : constant Opt_N_Subexpr_Id := First_Actual (N);
+      Arg2     : constant Opt_N_Subexpr_Id :=
+        (if Num_Args > 1 then Next_Actual (Arg1) else Empty);
+      Arg3     : constant Opt_N_Subexpr_Id :=
+        (if Num_Args > 2 then Next_Actual (Arg2) else Empty);
+      Res_GT   : constant GL_Type          :=
+        (if Is_Func then Full_GL_Type (N) else No_GL_Type);
+      Binary   : constant Boolean          :=
+        Op in "add" | "sub" | "mul" | "div" | "rem" | "and" | "or" | "xor"
+            | "shl" | "shr" | "min" | "max";
+      Unary    : constant Boolean          := Op in "neg" | "abs" | "not";
+      Compare  : constant Boolean          :=
+        Op in "eq" | "ne" | "lt" | "le" | "gt" | "ge";
+      Vec_GT   : GL_Type                   := No_GL_Type;
+      Mask     : Opt_N_Subexpr_Id          := Empty;
+      Addr     : Opt_N_Subexpr_Id          := Empty;
+      A, B     : Opt_N_Subexpr_Id          := Empty;
+
+      function Is_Vector_Of (Expr : Node_Id; GT : GL_Type) return Boolean
+      is
+        (Present (GT) and then Vector_Lanes (GT) in 2 | 4 | 8 | 16 | 32 | 64
+           and then Type_Of (Full_GL_Type (Expr)) = Type_Of (GT));
+      --  True if Expr is of an array type that we can use as a vector and
+      --  that's laid out like GT. As for the vector_type attribute, the
+      --  number of lanes must be a power of two no larger than 64.
+
+      function Is_Mask_For (GT, For_GT : GL_Type) return Boolean is
+        (Present (GT) and then Vector_Lanes (GT) = Vector_Lanes (For_GT)
+           and then Is_Integer_Type (Full_Component_Type (GT)));
+      --  True if GT is a vector type with integer components that can be
+      --  used as a mask for For_GT.
+
+   begin
+      --  First identify the operands from the operation and check their
+      --  types. The lane-wise operations and comparisons are on operands
+      --  of the same type, the selection takes a mask as its first
+      --  operand and the shuffle as its last one. The masked load and
+      --  store operate on an address.
+
+      if Reduce and then Is_Func and then Num_Args = 1
+        and then Op in "add" | "mul" | "and" | "or" | "xor" | "min" | "max"
+      then
+         A      := Arg1;
+         Vec_GT := Full_GL_Type (A);
+
+         if not Is_Vector_Of (A, Vec_GT)
+           or else Type_Of (Res_GT) /= Get_Element_Type (Type_Of (Vec_GT))
+           or else Is_Floating_Point_Type (Res_GT) /=
+                     Is_Floating_Point_Type (Full_Component_Type (Vec_GT))
+           or else (Op in "and" | "or" | "xor"
+                      and then Is_Floating_Point_Type (Res_GT))
+         then
+            return No_GL_Value;
+         end if;
+
+      elsif Reduce then
+         return No_GL_Value;
+
+      elsif Is_Func and then (Binary or else Compare) and then Num_Args = 2
+      then
+         A      := Arg1;
+         B      := Arg2;
+         Vec_GT := Full_GL_Type (A);
+
+         if not Is_Vector_Of (B, Vec_GT)
+           or else (Binary and then not Is_Vector_Of (N, Vec_GT))
+           or else (Compare and then not Is_Mask_For (Res_GT, Vec_GT))
+         then
+            return No_GL_Value;
+         end if;
+
+      elsif Is_Func and then Unary and then Num_Args = 1 then
+         A      := Arg1;
+         Vec_GT := Res_GT;
+
+         if not Is_Vector_Of (A, Vec_GT) then
+            return No_GL_Value;
+         end if;
+
+      elsif Is_Func and then Num_Args = 3 and then Op in "select" | "shuffle"
+      then
+         A      := (if Op = "select" then Arg2 else Arg1);
+         B      := (if Op = "select" then Arg3 else Arg2);
+         Mask   := (if Op = "select" then Arg1 else Arg3);
+         Vec_GT := Res_GT;
+
+         if not Is_Vector_Of (A, Vec_GT) or else not Is_Vector_Of (B, Vec_GT)
+           or else not Is_Mask_For (Full_GL_Type (Mask), Vec_GT)
+         then
+            return No_GL_Value;
+         end if;
+
+      elsif Num_Args = 3
+        and then ((Is_Func and then Op = "masked_load")
+                    or else (not Is_Func and then Op = "masked_store"))
+      then
+         Addr   := Arg1;
+         Mask   := Arg2;
+         A      := Arg3;
+         Vec_GT := Full_GL_Type (A);
+
+         if not Is_Descendant_Of_Address (Full_GL_Type (Addr))
+           or else not Is_Vector_Of (A, Vec_GT)
+           or else (Is_Func and then not Is_Vector_Of (N, Vec_GT))
+           or else not Is_Mask_For (Full_GL_Type (Mask), Vec_GT)
+         then
+            return No_GL_Value;
+         end if;
+      else
+         return No_GL_Value;
+      end if;
+
+      --  Bitwise operations and shifts aren't valid on floating-point
+      --  lanes.
+
+      if Is_Floating_Point_Type (Full_Component_Type (Vec_GT))
+        and then Op in "and" | "or" | "xor" | "not" | "shl" | "shr"
+        and then not Reduce
+      then
+         return No_GL_Value;
+      end if;
+
+      declare
+         Lanes    : constant Nat      := Vector_Lanes (Vec_GT);
+         Comp_GT  : constant GL_Type  := Full_Component_GL_Type (Vec_GT);
+         FP       : constant Boolean  := Is_Floating_Point_Type (Comp_GT);
+         Uns      : constant Boolean  := Is_Unsigned_Type (Comp_GT);
+         Arr_T    : constant Type_T   := Type_Of (Vec_GT);
+         Elmt_T   : constant Type_T   := Get_Element_Type (Arr_T);
+         Vec_T    : constant Type_T   :=
+           Vector_Type (Elmt_T, unsigned (Lanes));
+         Use_Vec  : constant Boolean  := not Emit_C;
+         --  We use LLVM vector types unless we're generating C, in which
+         --  case we operate on each lane in turn. For targets without
+         --  vector instructions, LLVM does that itself.
+
+         Result   : GL_Value          := No_GL_Value;
+         Res_Vec  : Value_T;
+
+         function Align (GT : GL_Type) return unsigned is
+           (unsigned (Nat'(To_Bytes (Get_Type_Alignment (GT)))));
+         --  The alignment of GT in bytes
+
+         function Operand (Expr : N_Subexpr_Id) return Value_T;
+         --  Evaluate Expr. If we're using vectors, return it as a vector
+         --  value. Otherwise, return a pointer to it.
+
+         function Lane (V : Value_T; T : Type_T; J : Value_T) return Value_T;
+         --  Return the lane J of V, an operand of type T. If J is not
+         --  Present, we're using vectors and want all of V.
+
+         procedure Set_Lane (J : Value_T; V : Value_T);
+         --  Set the lane J of our result to V, or all of it if J is not
+         --  Present.
+
+         function Lane_Op (L, R : Value_T) return Value_T;
+         --  Perform the lane-wise operation on L and R, which are either
+         --  scalars or vectors. R is not Present for a unary operation.
+
+         function Lane_Compare
+           (Cmp : String; L, R : Value_T) return Value_T;
+         --  Likewise, but compare L and R and return an i1 or a vector of
+         --  them.
+
+         function Call_Intrinsic
+           (Name  : String;
+            Types : Type_Array;
+            Args  : Value_Array) return Value_T;
+         --  Call the overloaded intrinsic Name with Args
+
+         -------------
+         -- Operand --
+         -------------
+
+         function Operand (Expr : N_Subexpr_Id) return Value_T is
+            GT   : constant GL_Type := Full_GL_Type (Expr);
+            Ptr  : constant Value_T :=
+              +Get (Emit_Expression (Expr), Reference);
+            Inst : Value_T;
+
+         begin
+            if not Use_Vec then
+               return Ptr;
+            end if;
+
+            Inst := Load_2 (IR_Builder,
+                            Vector_Type (Get_Element_Type (Type_Of (GT)),
+                                         unsigned (Lanes)),
+                            Ptr, "");
+            Set_Alignment (Inst, Align (GT));
+            return Inst;
+         end Operand;
+
+         ----------
+         -- Lane --
+         ----------
+
+         function Lane (V : Value_T; T : Type_T; J : Value_T) return Value_T
+         is
+            Idxs : constant Value_Array (1 .. 2) :=
+              (Const_Null (Int_32_T), J);
+
+         begin
+            if No (J) then
+               return V;
+            elsif Use_Vec then
+               return Extract_Element (IR_Builder, V, J, "");
+            else
+               return Load_2 (IR_Builder, Get_Element_Type (T),
+                              In_Bounds_GEP2 (IR_Builder, T, V,
+                                              Idxs'Address, Idxs'Length, ""),
+                              "");
+            end if;
+         end Lane;
+
+         --------------
+         -- Set_Lane --
+         --------------
+
+         procedure Set_Lane (J : Value_T; V : Value_T) is
+            Idxs : constant Value_Array (1 .. 2) :=
+              (Const_Null (Int_32_T), J);
+            Inst : Value_T;
+
+         begin
+            if No (J) then
+               Inst := Build_Store (IR_Builder, V, +Result);
+               Set_Alignment (Inst, Align (Related_Type (Result)));
+            elsif Use_Vec then
+               Res_Vec := Insert_Element (IR_Builder, Res_Vec, V, J, "");
+            else
+               Discard (Build_Store (IR_Builder, V,
+                                     In_Bounds_GEP2
+                                       (IR_Builder,
+                                        Type_Of (Related_Type (Result)),
+                                        +Result, Idxs'Address, Idxs'Length,
+                                        "")));
+            end if;
+         end Set_Lane;
+
+         ------------------
+         -- Lane_Compare --
+         ------------------
+
+         function Lane_Compare
+           (Cmp : String; L, R : Value_T) return Value_T is
+         begin
+            if FP then
+               return F_Cmp (IR_Builder,
+                             (if    Cmp = "eq" then Real_OEQ
+                              elsif Cmp = "ne" then Real_UNE
+                              elsif Cmp = "lt" then Real_OLT
+                              elsif Cmp = "le" then Real_OLE
+                              elsif Cmp = "gt" then Real_OGT
+                              else  Real_OGE),
+                             L, R, "");
+            else
+               return I_Cmp (IR_Builder,
+                             (if    Cmp = "eq" then Int_EQ
+                              elsif Cmp = "ne" then Int_NE
+                              elsif Cmp = "lt" then (if Uns then Int_ULT
+                                                     else Int_SLT)
+                              elsif Cmp = "le" then (if Uns then Int_ULE
+                                                     else Int_SLE)
+                              elsif Cmp = "gt" then (if Uns then Int_UGT
+                                                     else Int_SGT)
+                              else  (if Uns then Int_UGE else Int_SGE)),
+                             L, R, "");
+            end if;
+         end Lane_Compare;
+
+         -------------
+         -- Lane_Op --
+         -------------
+
+         function Lane_Op (L, R : Value_T) return Value_T is
+         begin
+            if Op = "min" then
+               return Build_Select (IR_Builder, Lane_Compare ("lt", L, R),
+                                    L, R, "");
+            elsif Op = "max" then
+               return Build_Select (IR_Builder, Lane_Compare ("gt", L, R),
+                                    L, R, "");
+            elsif Op = "neg" then
+               return (if   FP then F_Neg (IR_Builder, L, "")
+                       else Neg (IR_Builder, L, ""));
+            elsif Op = "not" then
+               return Build_Not (IR_Builder, L, "");
+            elsif Op = "abs" then
+               return Build_Select
+                 (IR_Builder,
+                  Lane_Compare ("lt", L, Const_Null (Type_Of (L))),
+                  (if FP then F_Neg (IR_Builder, L, "")
+                   else Neg (IR_Builder, L, "")),
+                  L, "");
+            else
+               return Bin_Op
+                 (IR_Builder,
+                  (if    Op = "add" then (if FP then Op_F_Add else Op_Add)
+                   elsif Op = "sub" then (if FP then Op_F_Sub else Op_Sub)
+                   elsif Op = "mul" then (if FP then Op_F_Mul else Op_Mul)
+                   elsif Op = "div"
+                   then  (if FP then Op_F_Div elsif Uns then Op_U_Div
+                          else Op_S_Div)
+                   elsif Op = "rem"
+                   then  (if FP then Op_F_Rem elsif Uns then Op_U_Rem
+                          else Op_S_Rem)
+                   elsif Op = "and" then Op_And
+                   elsif Op = "or"  then Op_Or
+                   elsif Op = "xor" then Op_Xor
+                   elsif Op = "shl" then Op_Shl
+                   else  (if Uns then Op_L_Shr else Op_A_Shr)),
+                  L, R, "");
+            end if;
+         end Lane_Op;
+
+         --------------------
+         -- Call_Intrinsic --
+         --------------------
+
+         function Call_Intrinsic
+           (Name  : String;
+            Types : Type_Array;
+            Args  : Value_Array) return Value_T
+         is
+            Fn : constant Value_T :=
+              Get_Intrinsic_Declaration
+                (Module, Lookup_Intrinsic_ID (Name, Name'Length),
+                 Types'Address, Types'Length);
+
+         begin
+            return Call_2 (IR_Builder, Global_Get_Value_Type (Fn), Fn,
+                           Args'Address, Args'Length, "");
+         end Call_Intrinsic;
+
+         Val_A    : constant Value_T :=
+           (if Present (A) then Operand (A) else No_Value_T);
+         Val_B    : constant Value_T :=
+           (if Present (B) then Operand (B) else No_Value_T);
+         Val_Mask : constant Value_T :=
+           (if Present (Mask) then Operand (Mask) else No_Value_T);
+         Mask_T   : constant Type_T  :=
+           (if Present (Mask) then Type_Of (Full_GL_Type (Mask))
+            else No_Type_T);
+         Ptr      : constant Value_T :=
+           (if   Present (Addr)
+            then +Int_To_Ref (Emit_Expression (Addr), Vec_GT)
+            else No_Value_T);
+
+      begin
+         --  For a reduction, combine all the lanes. If we're using
+         --  vectors, LLVM has intrinsics that do that.
+
+         if Reduce then
+            if Use_Vec and then FP and then Op in "add" | "mul" then
+               return G (Call_Intrinsic
+                           ("llvm.vector.reduce.f" & Op, (1 => Vec_T),
+                            (1 => (if   Op = "add"
+                                   then F_Neg (IR_Builder,
+                                               Const_Real (Elmt_T, 0.0), "")
+                                   else Const_Real (Elmt_T, 1.0)),
+                             2 => Val_A)),
+                         Res_GT);
+            elsif Use_Vec then
+               return G (Call_Intrinsic
+                           ("llvm.vector.reduce."
+                            & (if    Op not in "min" | "max" then ""
+                               elsif FP then "f"
+                               elsif Uns then "u" else "s")
+                            & Op,
+                            (1 => Vec_T), (1 => Val_A)),
+                         Res_GT);
+            end if;
+
+            Res_Vec := Lane (Val_A, Arr_T, Const_Null (Int_32_T));
+
+            for J in 1 .. Lanes - 1 loop
+               Res_Vec := Lane_Op (Res_Vec,
+                                   Lane (Val_A, Arr_T,
+                                         Const_Int (Int_32_T, ULL (J),
+                                                    False)));
+            end loop;
+
+            return G (Res_Vec, Res_GT);
+
+         --  For the masked store, store the lanes of A whose mask is
+         --  nonzero.
+
+         elsif Op = "masked_store" and then Use_Vec then
+            Discard (Call_Intrinsic
+                       ("llvm.masked.store", (1 => Vec_T, 2 => Type_Of (Ptr)),
+                        (1 => Val_A,
+                         2 => Ptr,
+                         3 => Const_Int (Int_32_T, ULL (Align (Comp_GT)),
+                                         False),
+                         4 => I_Cmp (IR_Builder, Int_NE, Val_Mask,
+                                     Const_Null (Type_Of (Val_Mask)), ""))));
+            return Const_True;
+         end if;
+
+         --  Otherwise, we have a result, which is either a copy of A or
+         --  computed lane by lane. When we're using vectors and compute it
+         --  lane by lane, we build it up as a vector value and then store
+         --  it into the result, like the other operations.
+
+         if Is_Func then
+            Result  := Allocate_For_Type (Res_GT);
+            Res_Vec := Get_Undef (Vec_T);
+         end if;
+
+         if Op = "masked_load" and then Use_Vec then
+            Set_Lane (No_Value_T,
+                      Call_Intrinsic
+                        ("llvm.masked.load", (1 => Vec_T, 2 => Type_Of (Ptr)),
+                         (1 => Ptr,
+                          2 => Const_Int (Int_32_T, ULL (Align (Comp_GT)),
+                                          False),
+                          3 => I_Cmp (IR_Builder, Int_NE, Val_Mask,
+                                      Const_Null (Type_Of (Val_Mask)), ""),
+                          4 => Val_A)));
+
+         --  Without vectors, the masked operations test the mask of each
+         --  lane and only access that lane of memory if it's nonzero.
+
+         elsif Op in "masked_load" | "masked_store" then
+            for J in 0 .. Lanes - 1 loop
+               declare
+                  Idx     : constant Value_T       :=
+                    Const_Int (Int_32_T, ULL (J), False);
+                  BB_Lane : constant Basic_Block_T := Create_Basic_Block;
+                  BB_Next : constant Basic_Block_T := Create_Basic_Block;
+
+               begin
+                  if Is_Func then
+                     Set_Lane (Idx, Lane (Val_A, Arr_T, Idx));
+                  end if;
+
+                  Discard (Build_Cond_Br
+                             (IR_Builder,
+                              I_Cmp (IR_Builder, Int_NE,
+                                     Lane (Val_Mask, Mask_T, Idx),
+                                     Const_Null (Get_Element_Type (Mask_T)),
+                                     ""),
+                              BB_Lane, BB_Next));
+                  Position_Builder_At_End (BB_Lane);
+
+                  if Is_Func then
+                     Set_Lane (Idx, Lane (Ptr, Arr_T, Idx));
+                  else
+                     declare
+                        Idxs : constant Value_Array (1 .. 2) :=
+                          (Const_Null (Int_32_T), Idx);
+
+                     begin
+                        Discard (Build_Store
+                                   (IR_Builder, Lane (Val_A, Arr_T, Idx),
+                                    In_Bounds_GEP2 (IR_Builder, Arr_T, Ptr,
+                                                    Idxs'Address,
+                                                    Idxs'Length, "")));
+                     end;
+                  end if;
+
+                  Build_Br (BB_Next);
+                  Position_Builder_At_End (BB_Next);
+               end;
+            end loop;
+
+            if not Is_Func then
+               return Const_True;
+            end if;
+
+         --  A shuffle selects each lane of the result from the lanes of A
+         --  and B given by the corresponding lane of the mask, modulo
+         --  twice the number of lanes. We always do this lane by lane, but
+         --  LLVM turns this into a shuffle if the mask is constant. We do
+         --  the arithmetic on the lanes of the mask as unsigned 32-bit
+         --  values, since twice the number of lanes may not fit in the
+         --  components of the mask. Truncating wider lanes doesn't change
+         --  the remainder, since twice the number of lanes divides 2**32.
+
+         elsif Op = "shuffle" then
+            declare
+               Count : constant Value_T :=
+                 Const_Int (Int_32_T, ULL (Lanes), False);
+
+            begin
+               for J in 0 .. Lanes - 1 loop
+                  declare
+                     Idx   : constant Value_T :=
+                       U_Rem (IR_Builder,
+                              Int_Cast_2
+                                (IR_Builder,
+                                 Lane (Val_Mask, Mask_T,
+                                       Const_Int (Int_32_T, ULL (J), False)),
+                                 Int_32_T, False, ""),
+                              Const_Int (Int_32_T, ULL (2 * Lanes), False),
+                              "");
+                     From  : constant Value_T :=
+                       U_Rem (IR_Builder, Idx, Count, "");
+
+                  begin
+                     Set_Lane (Const_Int (Int_32_T, ULL (J), False),
+                               Build_Select
+                                 (IR_Builder,
+                                  I_Cmp (IR_Builder, Int_UGE, Idx, Count, ""),
+                                  Lane (Val_B, Arr_T, From),
+                                  Lane (Val_A, Arr_T, From), ""));
+                  end;
+               end loop;
+            end;
+
+         --  Otherwise, this is a lane-wise operation, which we do all at
+         --  once if we're using vectors.
+
+         else
+            for J in 0 .. (if Use_Vec then 0 else Lanes - 1) loop
+               declare
+                  Idx   : constant Value_T :=
+                    (if   Use_Vec then No_Value_T
+                     else Const_Int (Int_32_T, ULL (J), False));
+                  Res_T : constant Type_T  :=
+                    (if   Use_Vec
+                     then Vector_Type (Get_Element_Type (Type_Of (Res_GT)),
+                                       unsigned (Lanes))
+                     else Get_Element_Type (Type_Of (Res_GT)));
+
+               begin
+                  if Compare then
+                     Set_Lane (Idx,
+                               S_Ext (IR_Builder,
+                                      Lane_Compare (Op,
+                                                    Lane (Val_A, Arr_T, Idx),
+                                                    Lane (Val_B, Arr_T, Idx)),
+                                      Res_T, ""));
+                  elsif Op = "select" then
+                     Set_Lane (Idx,
+                               Build_Select
+                                 (IR_Builder,
+                                  I_Cmp (IR_Builder, Int_NE,
+                                         Lane (Val_Mask, Mask_T, Idx),
+                                         Const_Null
+                                           (if   Use_Vec
+                                            then Type_Of (Val_Mask)
+                                            else Get_Element_Type (Mask_T)),
+                                         ""),
+                                  Lane (Val_A, Arr_T, Idx),
+                                  Lane (Val_B, Arr_T, Idx), ""));
+                  else
+                     Set_Lane (Idx,
+                               Lane_Op (Lane (Val_A, Arr_T, Idx),
+                                        (if   Present (Val_B)
+                                         then Lane (Val_B, Arr_T, Idx)
+                                         else No_Value_T)));
+                  end if;
+               end;
+            end loop;
+
+            return Result;
+         end if;
+
+         --  If we built up a vector one lane at a time, store it
+
+         if Use_Vec and then Op /= "masked_load" then
+            Set_Lane (No_Value_T, Res_Vec);
+         end if;
+
+         return Result;
+      end;
+   end Emit_Vector_Call;
+
    -------------------------
    -- Emit_Intrinsic_Call --
    -------------------------
@@ -1314,6 +1904,13 @@ package body GNATLLVM.Builtins is
       then
          return Emit_Atomic_Call (N, S (First + 9 .. S'Last));
 
+      --  Check for the lane-wise operations on arrays used as vectors
+
+      elsif S'Length > 17
+        and then S (First .. First + 16) = "__builtin_vector_"
+      then
+         return Emit_Vector_Call (N, S (First + 17 .. S'Last));
+
       --  Now see if this is a FP builtin
 
       elsif Nkind (N) = N_Function_Call then
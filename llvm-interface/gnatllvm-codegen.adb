@@ -21,6 +21,7 @@ with Ada.Strings.Fixed; use Ada.Strings.Fixed;
 with Interfaces;
 with Interfaces.C;      use Interfaces.C;
 with System;            use System;
+with System.Multiprocessors;
 with System.OS_Lib;     use System.OS_Lib;
 
 with LLVM.Analysis;   use LLVM.Analysis;
@@ -34,6 +35,7 @@ with CCG; use CCG;
 
 with Debug;    use Debug;
 with Errout;   use Errout;
+with Gnatvsn;  use Gnatvsn;
 with Set_Targ; use Set_Targ;
 with Lib;      use Lib;
 with Opt;      use Opt;
@@ -77,9 +79,202 @@ package body GNATLLVM.Codegen is
 
    Dump_Targets                   : Boolean := False;
 
+   Default_Profile_Raw_Name       : constant String := "default_%m.profraw";
+   Default_Profile_Data_Name      : constant String := "default.profdata";
+   --  Default names of the raw profile written by an instrumented program
+   --  and of the indexed profile read back, as for clang.
+
    procedure Process_Switch (S : String);
    --  Process one command-line switch
 
+   function Split_Linker return String_Access;
+   --  Return the linker to use to combine the partitions of the module
+   --  that we generate code for in parallel into a single object file, or
+   --  null if we can't do that for this target.
+
+   procedure Write_Split_Object
+     (S : String; Linker : String; GNAT_Root : N_Compilation_Unit_Id);
+   --  Write the object file S for the module by generating code for
+   --  Codegen_Partitions pieces of it in parallel and combining them with
+   --  Linker.
+
+   procedure Set_Profile_File (Which : in out String_Access; Name : String);
+   --  Make Name the only profile-guided optimization file, setting Which,
+   --  which must be one of Profile_Gen_File, Profile_Use_File, or
+   --  Sample_Profile_File, and clearing the other two.
+
+   function Compile_Cache_Options return String;
+   --  Return a string describing everything besides the module itself
+   --  that affects the code we generate, for use in compile cache keys
+
+   procedure Start_Phase (Name : String) with Inline;
+   procedure End_Phase   (Name : String) with Inline;
+   --  Start or stop timing the code generation phase Name if -ftime-report
+
+   ---------------------------
+   -- Compile_Cache_Options --
+   ---------------------------
+
+   function Compile_Cache_Options return String is
+      function Img (B : Boolean) return String is (if B then "1" else "0");
+
+      function Img (S : String_Access) return String is
+        ((if S = null then "" else S.all));
+
+      function LLVM_Switches (J : Interfaces.C.int) return String is
+        ((if   J > Switches.Last then ""
+          else Switches.Table (J).all & " " & LLVM_Switches (J + 1)));
+      --  All the -llvm- switches starting from the Jth one
+
+   begin
+      --  The name of a profile is irrelevant (we hash its contents), but
+      --  a raw profile written by an instrumented program is named in
+      --  the code.
+
+      return Gnat_Version_String & ";"
+        & Code_Generation_Kind'Image (Code_Generation) & ";"
+        & Normalized_Target_Triple.all & ";" & CPU.all & ";" & ABI.all & ";"
+        & Features.all & ";" & Img (Target_Layout) & ";"
+        & Code_Gen_Opt_Level_T'Image (Code_Gen_Level) & ";"
+        & Code_Model_T'Image (Code_Model) & ";"
+        & Reloc_Mode_T'Image (Reloc_Mode) & ";"
+        & Int'Image (Code_Opt_Level) & Int'Image (Size_Opt_Level) & ";"
+        & Img (No_Implicit_Float) & Img (DSO_Preemptable)
+        & Img (No_Unroll_Loops) & Img (No_Loop_Vectorization)
+        & Img (No_SLP_Vectorization) & Img (Merge_Functions)
+        & Img (Prepare_For_Thin_LTO) & Img (Prepare_For_LTO)
+        & Img (Reroll_Loops) & Img (Enable_Fuzzer)
+        & Img (Enable_Address_Sanitizer) & ";"
+        & Img (San_Cov_Allow_List) & ";" & Img (San_Cov_Ignore_List) & ";"
+        & Img (Profile_Gen_File) & ";" & Img (Sample_Profile_File /= null)
+        & ";" & LLVM_Switches (1);
+   end Compile_Cache_Options;
+
+   -----------------
+   -- Start_Phase --
+   -----------------
+
+   procedure Start_Phase (Name : String) is
+   begin
+      if Time_Report then
+         Time_Report_Start_Phase (Name);
+      end if;
+   end Start_Phase;
+
+   ---------------
+   -- End_Phase --
+   ---------------
+
+   procedure End_Phase (Name : String) is
+   begin
+      if Time_Report then
+         Time_Report_End_Phase (Name);
+      end if;
+   end End_Phase;
+
+   ------------------
+   -- Split_Linker --
+   ------------------
+
+   function Split_Linker return String_Access is
+      Linker : String_Access;
+
+   begin
+      --  We need a linker that can produce a relocatable object, which
+      --  rules out non-ELF targets. ld.lld handles every ELF target, but
+      --  the system linker is only suitable for native compilations.
+
+      if not Has_ELF_Object_Format (Normalized_Target_Triple.all) then
+         return null;
+      end if;
+
+      Linker := Locate_Exec_On_Path ("ld.lld");
+
+      if Linker = null and then not Target_Triple_Set then
+         Linker := Locate_Exec_On_Path ("ld");
+      end if;
+
+      return Linker;
+   end Split_Linker;
+
+   ------------------------
+   -- Write_Split_Object --
+   ------------------------
+
+   procedure Write_Split_Object
+     (S : String; Linker : String; GNAT_Root : N_Compilation_Unit_Id)
+   is
+      function Part_Name (J : Nat) return String is
+        (S & "." & Trim (Nat'Image (J), Ada.Strings.Left));
+      --  Name of the object file for partition J, as written by
+      --  Emit_Split_Module.
+
+      Args    : Argument_List (1 .. Integer (Codegen_Partitions) + 3);
+      Err_Msg : aliased Ptr_Err_Msg_Type;
+      Success : Boolean;
+
+   begin
+      if Emit_Split_Module
+        (Module, Target_Machine, Codegen_Partitions, S, Err_Msg'Address)
+      then
+         Error_Msg_N ("could not write `" & S & "`: " &
+                        Get_LLVM_Error_Msg (Err_Msg), GNAT_Root);
+      else
+         Args (1) := new String'("-r");
+         Args (2) := new String'("-o");
+         Args (3) := new String'(S);
+
+         for J in 0 .. Codegen_Partitions - 1 loop
+            Args (Integer (J) + 4) := new String'(Part_Name (J));
+         end loop;
+
+         Spawn (Linker, Args, Success);
+
+         if not Success then
+            Error_Msg_N ("could not link `" & S & "` with " & Linker,
+                         GNAT_Root);
+         end if;
+
+         for J in Args'Range loop
+            Free (Args (J));
+         end loop;
+      end if;
+
+      --  Remove the partitions, whether or not we succeeded
+
+      for J in 0 .. Codegen_Partitions - 1 loop
+         Delete_File (Part_Name (J), Success);
+      end loop;
+   end Write_Split_Object;
+
+   ----------------------
+   -- Set_Profile_File --
+   ----------------------
+
+   procedure Set_Profile_File (Which : in out String_Access; Name : String)
+   is
+   begin
+      Free (Profile_Gen_File);
+      Free (Profile_Use_File);
+      Free (Sample_Profile_File);
+      Which := new String'(Name);
+   end Set_Profile_File;
+
+   ---------------------------------------
+   -- Start_Compile_Server_If_Requested --
+   ---------------------------------------
+
+   procedure Start_Compile_Server_If_Requested is
+   begin
+      if Argument_Count = 1
+        and then Starts_With (Argument (1), "--compile-server=")
+        and then not Run_Compile_Server
+                       (Switch_Value (Argument (1), "--compile-server="))
+      then
+         Early_Error ("cannot start compile server on " & Argument (1));
+      end if;
+   end Start_Compile_Server_If_Requested;
+
    --------------------------
    -- Initialize_GNAT_LLVM --
    --------------------------
@@ -132,6 +327,22 @@ package body GNATLLVM.Codegen is
          Output_Assembly := True;
       elsif S = "-fuse-gnat-allocs" then
          Use_GNAT_Allocs := True;
+      elsif S = "-gline-tables-only" then
+         Emit_Debug_Info      := True;
+         Emit_Full_Debug_Info := False;
+      elsif S = "-gsplit-dwarf" then
+         Split_DWARF := True;
+
+         --  There's nothing to split without debug info, so this implies
+         --  -g unless we already have some level of it.
+
+         if not Emit_Debug_Info then
+            Emit_Debug_Info      := True;
+            Emit_Full_Debug_Info := True;
+         end if;
+
+      elsif S = "-gno-split-dwarf" then
+         Split_DWARF := False;
       elsif S = "-g"
         or else (Starts_With (S, "-g") and then not Starts_With (S, "-gnat"))
       then
@@ -147,6 +358,96 @@ package body GNATLLVM.Codegen is
          Optimize_IR := False;
       elsif S = "--dump-targets" then
          Dump_Targets := True;
+      elsif S = "-fparallel-codegen" then
+         Codegen_Partitions :=
+           Nat (System.Multiprocessors.Number_Of_CPUs);
+      elsif Starts_With (S, "-fparallel-codegen=") then
+         begin
+            Codegen_Partitions :=
+              Nat'Value (Switch_Value (S, "-fparallel-codegen="));
+         exception
+            when Constraint_Error =>
+               Early_Error ("invalid number of partitions: " & S);
+         end;
+
+         if Codegen_Partitions = 0 then
+            Early_Error ("invalid number of partitions: " & S);
+         end if;
+
+      elsif Starts_With (S, "-fcompile-cache=") then
+         To_Free           := Compile_Cache_Dir;
+         Compile_Cache_Dir :=
+           new String'(Switch_Value (S, "-fcompile-cache="));
+      elsif S = "-fno-compile-cache" then
+         To_Free           := Compile_Cache_Dir;
+         Compile_Cache_Dir := null;
+      elsif Starts_With (S, "-fcompile-cache-size=") then
+         declare
+            Megabyte : constant ULL := 1024 * 1024;
+            Size     : ULL;
+
+         begin
+            Size := ULL'Value (Switch_Value (S, "-fcompile-cache-size="));
+            if Size > ULL'Last / Megabyte then
+               Early_Error ("invalid compile cache size: " & S);
+            else
+               Compile_Cache_Max_Size := Size * Megabyte;
+            end if;
+
+         exception
+            when Constraint_Error =>
+               Early_Error ("invalid compile cache size: " & S);
+         end;
+
+      elsif S = "-fcompile-cache-stats" then
+         Compile_Cache_Stats_Flag := True;
+      elsif S = "-ftime-report" then
+         Time_Report := True;
+      elsif S = "-fno-time-report" then
+         Time_Report := False;
+      elsif S = "-fsave-optimization-record" then
+
+         --  Remarks are located through line tables, so we need those
+
+         Optimization_Record := True;
+         Emit_Debug_Info     := True;
+      elsif S = "-fno-save-optimization-record" then
+         Optimization_Record := False;
+      elsif Starts_With (S, "-fproof-results=") then
+         To_Free           := Proof_Results_Dir;
+         Proof_Results_Dir :=
+           new String'(Switch_Value (S, "-fproof-results="));
+      elsif S = "-fno-proof-results" then
+         To_Free           := Proof_Results_Dir;
+         Proof_Results_Dir := null;
+      elsif S = "-freorder-record-components" then
+         Reorder_Components := True;
+      elsif S = "-freorder-record-components-report" then
+         Reorder_Components        := True;
+         Reorder_Components_Report := True;
+      elsif S = "-fno-reorder-record-components" then
+         Reorder_Components        := False;
+         Reorder_Components_Report := False;
+      elsif S = "-fstack-usage" then
+         Stack_Usage := True;
+      elsif S = "-fno-stack-usage" then
+         Stack_Usage := False;
+      elsif S = "-fcheck-stats" then
+         Check_Stats := True;
+      elsif S = "-fno-check-stats" then
+         Check_Stats := False;
+      elsif S = "-fcold-checks" then
+         Cold_Checks := True;
+      elsif S = "-fno-cold-checks" then
+         Cold_Checks := False;
+      elsif S = "-fspark-noalias" then
+         SPARK_Noalias := True;
+      elsif S = "-fno-spark-noalias" then
+         SPARK_Noalias := False;
+      elsif Starts_With (S, "-foptimization-record-passes=") then
+         To_Free                    := Optimization_Record_Passes;
+         Optimization_Record_Passes :=
+           new String'(Switch_Value (S, "-foptimization-record-passes="));
       elsif Starts_With (S, "--target=") then
          To_Free           := Target_Triple;
          Target_Triple     := new String'(Switch_Value (S, "--target="));
@@ -406,6 +707,73 @@ package body GNATLLVM.Codegen is
             To_Free             := San_Cov_Ignore_List;
             San_Cov_Ignore_List := new String'(Name);
          end;
+
+      --  Profile-guided optimization switches follow clang: a directory
+      --  given to -fprofile-generate= receives the raw profile under its
+      --  default name, while -fprofile-instr-generate= names the file
+      --  itself, and a directory given to -fprofile-use= is searched for
+      --  the default indexed profile. The last of these switches wins.
+
+      elsif S in "-fprofile-generate" | "-fprofile-instr-generate" then
+         Set_Profile_File (Profile_Gen_File, Default_Profile_Raw_Name);
+      elsif Starts_With (S, "-fprofile-generate=") then
+         Set_Profile_File
+           (Profile_Gen_File,
+            Switch_Value (S, "-fprofile-generate=") & Directory_Separator &
+              Default_Profile_Raw_Name);
+      elsif Starts_With (S, "-fprofile-instr-generate=") then
+         Set_Profile_File
+           (Profile_Gen_File, Switch_Value (S, "-fprofile-instr-generate="));
+      elsif S in "-fprofile-use" | "-fprofile-instr-use"
+        or else Starts_With (S, "-fprofile-use=")
+        or else Starts_With (S, "-fprofile-instr-use=")
+      then
+         declare
+            Path : constant String :=
+              (if    Starts_With (S, "-fprofile-use=")
+               then  Switch_Value (S, "-fprofile-use=")
+               elsif Starts_With (S, "-fprofile-instr-use=")
+               then  Switch_Value (S, "-fprofile-instr-use=")
+               else  "");
+            Name : constant String :=
+              (if    Path = "" then Default_Profile_Data_Name
+               elsif Is_Directory (Path)
+               then  Path & Directory_Separator & Default_Profile_Data_Name
+               else  Path);
+
+         begin
+            if not Is_Regular_File (Name) then
+               Early_Error ("profile file not found: " & Name);
+            end if;
+
+            Set_Profile_File (Profile_Use_File, Name);
+         end;
+
+      elsif Starts_With (S, "-fprofile-sample-use=") then
+         declare
+            Name : constant String :=
+              Switch_Value (S, "-fprofile-sample-use=");
+
+         begin
+            if not Is_Regular_File (Name) then
+               Early_Error ("sample profile file not found: " & Name);
+            end if;
+
+            --  Sample profiles are matched to the code through line
+            --  tables, so we need at least those.
+
+            Set_Profile_File (Sample_Profile_File, Name);
+            Emit_Debug_Info := True;
+         end;
+
+      elsif S in "-fno-profile-generate" | "-fno-profile-instr-generate"
+        | "-fno-profile-use" | "-fno-profile-instr-use"
+        | "-fno-profile-sample-use"
+      then
+         Free (Profile_Gen_File);
+         Free (Profile_Use_File);
+         Free (Sample_Profile_File);
+
       elsif Starts_With (S, "-fpass-plugin=") then
          To_Free := Pass_Plugin_Name;
          Pass_Plugin_Name := new String'(Switch_Value (S, "-fpass-plugin="));
@@ -698,9 +1066,13 @@ package body GNATLLVM.Codegen is
    -------------------
 
    procedure Generate_Code (GNAT_Root : N_Compilation_Unit_Id) is
-      TT_First : constant Integer  := Target_Triple'First;
-      Verified : Boolean           := True;
-      Err_Msg  : aliased Ptr_Err_Msg_Type;
+      TT_First  : constant Integer  := Target_Triple'First;
+      Verified  : Boolean           := True;
+      Cache_Key : String_Access     := null;
+      Cache_Ext : String_Access     := null;
+      Cache_Hit : Boolean           := False;
+      Stack_Use : Boolean           := False;
+      Err_Msg   : aliased Ptr_Err_Msg_Type;
 
    begin
       --  We always want to write IR, even if there were errors.
@@ -708,8 +1080,10 @@ package body GNATLLVM.Codegen is
       --  for decls.
 
       if not Decls_Only then
+         Start_Phase ("verify");
          Verified :=
            not Verify_Module (Module, Print_Message_Action, Null_Address);
+         End_Phase ("verify");
       end if;
 
       --  Unless just writing IR, suppress doing anything else if it fails
@@ -721,14 +1095,66 @@ package body GNATLLVM.Codegen is
          Code_Generation := None;
       end if;
 
+      --  If we have a compile cache, see if it already has the code we're
+      --  to generate. We compute the key before optimization since that
+      --  and code generation are what we want to avoid. We can't cache C
+      --  because it also depends on front end data that isn't in the IR,
+      --  nor the effect of a pass plugin, and we need to run the
+      --  optimizer to get its remarks and the checks that survive it and
+      --  the code generator to get the stack usage. Nor do we cache the
+      --  .dwo file of split DWARF.
+
+      if Compile_Cache_Dir /= null
+        and then not Decls_Only
+        and then Code_Generation in Write_Assembly | Write_Object
+        and then Pass_Plugin_Name = null
+        and then not Optimization_Record
+        and then not Stack_Usage
+        and then not Check_Stats
+        and then not Emit_DWO
+      then
+         declare
+            Ext : constant String :=
+              (if Code_Generation = Write_Object then ".o" else ".s");
+            Key : constant String :=
+              Compile_Cache_Key
+                (Module, Compile_Cache_Options,
+                 (if   Profile_Use_File /= null then Profile_Use_File
+                  else Sample_Profile_File));
+
+         begin
+            if Key /= "" then
+               Cache_Key := new String'(Key);
+               Cache_Ext := new String'(Ext);
+               Cache_Hit :=
+                 Compile_Cache_Lookup
+                   (Compile_Cache_Dir.all, Key, Ext, Output_File_Name (Ext));
+
+               if Cache_Hit then
+                  Code_Generation := None;
+               end if;
+            end if;
+         end;
+      end if;
+
+      --  If asked for statistics on runtime checks, count the ones we
+      --  emitted before the optimizer removes some of them.
+
+      if Check_Stats and then not Decls_Only then
+         Record_Emitted_Checks (Module);
+      end if;
+
       --  If we're generating code or being asked to optimize IR before
       --  writing it, perform optimization. But don't do this if just
-      --  generating decls.
+      --  generating decls or if we found the code in the compile cache.
 
       if not Decls_Only
+        and then not Cache_Hit
         and then (Code_Generation in Write_Assembly | Write_Object | Write_C
                     or else Optimize_IR)
       then
+         Start_Phase ("optimize");
+
          --  For nvptx, include the math library in a form where we can
          --  inline from it.
 
@@ -796,6 +1222,12 @@ package body GNATLLVM.Codegen is
                San_Cov_Allow_List       => San_Cov_Allow_List,
                San_Cov_Ignore_List      => San_Cov_Ignore_List,
                Pass_Plugin_Name         => Pass_Plugin_Name,
+               Profile_Gen_File         => Profile_Gen_File,
+               Profile_Use_File         => Profile_Use_File,
+               Sample_Profile_File      => Sample_Profile_File,
+               Time_Report              => Time_Report,
+               Opt_Remarks              => Optimization_Record,
+               Opt_Remarks_Passes       => Optimization_Record_Passes,
                Error_Message            => Err_Msg'Address)
             then
                Error_Msg_N ("could not optimize: " &
@@ -803,10 +1235,33 @@ package body GNATLLVM.Codegen is
                             GNAT_Root);
             end if;
          end if;
+
+         End_Phase ("optimize");
+      end if;
+
+      --  If asked for the stack usage of our subprograms, have the code
+      --  generator record the size of their frames. When preparing for
+      --  link-time optimization, it's the linker that generates code.
+
+      if Stack_Usage
+        and then Code_Generation in Write_Assembly | Write_Object
+      then
+         if Code_Generation = Write_Object
+           and then (Prepare_For_Thin_LTO or else Prepare_For_LTO)
+         then
+            Error_Msg_N ("??stack usage not available with link-time " &
+                           "optimization", GNAT_Root);
+         else
+            Set_Stack_Usage_Output
+              (Target_Machine, Output_File_Name (".su") & ".raw");
+            Stack_Use := True;
+         end if;
       end if;
 
       --  Output the translation
 
+      Start_Phase ("emit");
+
       case Code_Generation is
          when Dump_IR =>
             Dump_Module (Module);
@@ -844,11 +1299,54 @@ package body GNATLLVM.Codegen is
          end Assembly;
 
          when Write_Object => Object : declare
-            S : constant String := Output_File_Name (".o");
+            S      : constant String  := Output_File_Name (".o");
+            LTO    : constant Boolean :=
+              Prepare_For_Thin_LTO or else Prepare_For_LTO;
+            DWO    : constant Boolean := Emit_DWO;
+            Split  : constant Boolean :=
+              Codegen_Partitions > 1 and then not LTO and then not DWO;
+            Linker : String_Access    :=
+              (if Split then Split_Linker else null);
 
          begin
-            if Target_Machine_Emit_To_File (Target_Machine, Module, S,
-                                            Object_File, Err_Msg'Address)
+            --  If asked to generate code in parallel but we can't combine
+            --  the pieces for this target, fall back to a single thread.
+
+            if Split and then Linker = null then
+               Error_Msg_N ("??parallel code generation not supported " &
+                              "for this target", GNAT_Root);
+            end if;
+
+            --  When preparing for link-time optimization, the object file
+            --  is bitcode, which the linker optimizes and generates code
+            --  for, like clang does.
+
+            if LTO then
+               if Write_LTO_Bitcode (Module, Target_Machine, S,
+                                     Prepare_For_Thin_LTO, Err_Msg'Address)
+               then
+                  Error_Msg_N ("could not write `" & S & "`: " &
+                                 Get_LLVM_Error_Msg (Err_Msg), GNAT_Root);
+               end if;
+
+            elsif Linker /= null then
+               Write_Split_Object (S, Linker.all, GNAT_Root);
+               Free (Linker);
+
+            --  With split DWARF, most of the debug information goes into a
+            --  .dwo file next to the object file, which the linker never
+            --  has to read.
+
+            elsif DWO then
+               if Emit_Object_With_Split_DWARF
+                 (Module, Target_Machine, S, Output_File_Name (".dwo"),
+                  Err_Msg'Address)
+               then
+                  Error_Msg_N ("could not write `" & S & "`: " &
+                                 Get_LLVM_Error_Msg (Err_Msg), GNAT_Root);
+               end if;
+            elsif Target_Machine_Emit_To_File (Target_Machine, Module, S,
+                                               Object_File, Err_Msg'Address)
             then
                Error_Msg_N ("could not write `" & S & "`: " &
                               Get_LLVM_Error_Msg (Err_Msg), GNAT_Root);
@@ -862,6 +1360,108 @@ package body GNATLLVM.Codegen is
             null;
       end case;
 
+      End_Phase ("emit");
+
+      --  If we looked for the code in the compile cache and didn't find
+      --  it, add what we've just written.
+
+      if Cache_Key /= null then
+         declare
+            S : constant String := Output_File_Name (Cache_Ext.all);
+
+         begin
+            if not Cache_Hit
+              and then Serious_Errors_Detected = 0
+              and then Compile_Cache_Store
+                         (Compile_Cache_Dir.all, Cache_Key.all, Cache_Ext.all,
+                          S, Compile_Cache_Max_Size, Err_Msg'Address)
+            then
+               Error_Msg_N ("??could not add `" & S & "` to compile cache: " &
+                              Get_LLVM_Error_Msg (Err_Msg), GNAT_Root);
+            end if;
+
+            if Compile_Cache_Stats_Flag then
+               declare
+                  Hits, Misses : Nat;
+
+               begin
+                  Compile_Cache_Stats (Compile_Cache_Dir.all, Hits, Misses);
+                  Write_Str ("compile cache: " &
+                               (if Cache_Hit then "hit" else "miss") &
+                               " for " & S & " (total" & Nat'Image (Hits) &
+                               " hits," & Nat'Image (Misses) & " misses)");
+                  Write_Eol;
+               end;
+            end if;
+         end;
+
+         Free (Cache_Key);
+         Free (Cache_Ext);
+      end if;
+
+      --  Write the time report next to the output file if requested
+
+      if Time_Report then
+         declare
+            S : constant String := Output_File_Name (".time.json");
+
+         begin
+            if Write_Time_Report (Filename.all, S, Err_Msg'Address) then
+               Error_Msg_N ("could not write `" & S & "`: " &
+                              Get_LLVM_Error_Msg (Err_Msg), GNAT_Root);
+            end if;
+         end;
+      end if;
+
+      --  Likewise for the optimization remarks
+
+      if Optimization_Record then
+         declare
+            S : constant String := Output_File_Name (".opt.json");
+
+         begin
+            if Write_Optimization_Remarks
+                 (Module, Filename.all, S, Err_Msg'Address)
+            then
+               Error_Msg_N ("could not write `" & S & "`: " &
+                              Get_LLVM_Error_Msg (Err_Msg), GNAT_Root);
+            end if;
+         end;
+      end if;
+
+      --  Likewise for the runtime checks that survived optimization
+
+      if Check_Stats and then not Decls_Only then
+         declare
+            S : constant String := Output_File_Name (".checks.json");
+
+         begin
+            if Write_Check_Stats (Module, Filename.all, S, Err_Msg'Address)
+            then
+               Error_Msg_N ("could not write `" & S & "`: " &
+                              Get_LLVM_Error_Msg (Err_Msg), GNAT_Root);
+            end if;
+         end;
+      end if;
+
+      --  Likewise for the stack usage and the call information needed to
+      --  combine it into the stack usage of a program.
+
+      if Stack_Use then
+         declare
+            S : constant String := Output_File_Name (".su");
+
+         begin
+            if Write_Stack_Usage
+                 (Module, Target_Machine, S, Output_File_Name (".ci"),
+                  Err_Msg'Address)
+            then
+               Error_Msg_N ("could not write `" & S & "`: " &
+                              Get_LLVM_Error_Msg (Err_Msg), GNAT_Root);
+            end if;
+         end;
+      end if;
+
       --  Release the environment
 
       if Emit_Debug_Info then
@@ -948,6 +1548,13 @@ package body GNATLLVM.Codegen is
    end Output_File_Name;
 
 begin
+   --  We don't own the main program of the compiler, so the elaboration of
+   --  this package is the earliest point at which we can become a compile
+   --  server. This must be done before anything reads the command line,
+   --  since the processes that perform compilations return here with the
+   --  command line of their client.
+
+   Start_Compile_Server_If_Requested;
    Initialize_GNAT_LLVM;
 
 end GNATLLVM.Codegen;
@@ -40,6 +40,7 @@ with GNATLLVM.DebugInfo;    use GNATLLVM.DebugInfo;
 with GNATLLVM.Environment;  use GNATLLVM.Environment;
 with GNATLLVM.Exprs;        use GNATLLVM.Exprs;
 with GNATLLVM.Instructions; use GNATLLVM.Instructions;
+with GNATLLVM.Proofs;       use GNATLLVM.Proofs;
 with GNATLLVM.Records;      use GNATLLVM.Records;
 with GNATLLVM.Types;        use GNATLLVM.Types;
 with GNATLLVM.Types.Create; use GNATLLVM.Types.Create;
@@ -209,6 +210,7 @@ package body GNATLLVM.Compile is
       GNATLLVM.Blocks.Initialize;
       GNATLLVM.Builtins.Initialize;
       GNATLLVM.DebugInfo.Initialize;
+      GNATLLVM.Proofs.Initialize (GNAT_Root);
       Detect_Duplicate_Global_Names;
       Stringt.Lock;
 
@@ -529,7 +531,14 @@ package body GNATLLVM.Compile is
             Emit_Reraise;
 
          when N_Raise_xxx_Error =>
-            Emit_Raise (N);
+
+            --  Omit a check that gnatprove proved can never fail
+
+            if No (Condition (N))
+              or else not Is_Proved (N, RT_Exception_Code'Val (+Reason (N)))
+            then
+               Emit_Raise (N);
+            end if;
 
          when N_Object_Declaration | N_Exception_Declaration =>
             Emit_Declaration (N);
@@ -195,8 +195,11 @@ package body GNATLLVM.DebugInfo is
            ((if   Ada_Version = Ada_83 then DWARF_Source_Language_Ada_83
              else DWARF_Source_Language_Ada_95),
             Get_Debug_File_Node (Our_Source_File), "GNAT/LLVM",
-            Code_Gen_Level /= Code_Gen_Level_None, "", 0, "",
-            DWARF_Emission_Full, 0, False, False, "", "");
+            Code_Gen_Level /= Code_Gen_Level_None, "", 0,
+            (if Emit_DWO then Output_File_Name (".dwo") else ""),
+            (if   Emit_Full_Debug_Info then DWARF_Emission_Full
+             else DWARF_Emission_Line_Tables_Only),
+            0, False, False, "", "");
 
          Empty_DI_Expr      :=
            DI_Builder_Create_Expression (DI_Builder, Exp'Access, 0);
@@ -713,9 +716,10 @@ package body GNATLLVM.DebugInfo is
       if Present (Result) then
          return Result;
 
-      --  Do nothing if not emitting debug info
+      --  Do nothing if not emitting debug info or only emitting line
+      --  tables.
 
-      elsif not Emit_Debug_Info then
+      elsif not Emit_Full_Debug_Info then
          return No_Metadata_T;
 
       --  If we've seen this type as part of elaboration (e.g., an access
@@ -39,6 +39,7 @@ with GNATLLVM.Conditionals; use GNATLLVM.Conditionals;
 with GNATLLVM.Conversions;  use GNATLLVM.Conversions;
 with GNATLLVM.Environment;  use GNATLLVM.Environment;
 with GNATLLVM.GLType;       use GNATLLVM.GLType;
+with GNATLLVM.Proofs;       use GNATLLVM.Proofs;
 with GNATLLVM.Records;      use GNATLLVM.Records;
 with GNATLLVM.Subprograms;  use GNATLLVM.Subprograms;
 with GNATLLVM.Types;        use GNATLLVM.Types;
@@ -789,6 +790,13 @@ package body GNATLLVM.Exprs is
       BB_Next    : Basic_Block_T;
 
    begin
+      --  There's nothing to do if gnatprove proved that the check can
+      --  never fail.
+
+      if Is_Proved (N, CE_Overflow_Check_Failed) then
+         return;
+      end if;
+
       --  If both types are integers, we determine the need for each check
       --  individually by seeing if the output bounds are tighter than the
       --  input bounds. But this isn't worth doing for FP since the
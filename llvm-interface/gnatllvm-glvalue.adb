@@ -1760,6 +1760,24 @@ package body GNATLLVM.GLValue is
       Add_Noalias_Attribute (+V);
    end Add_Noalias_Attribute;
 
+   ---------------------------------
+   -- Add_SPARK_Noalias_Attribute --
+   ---------------------------------
+
+   procedure Add_SPARK_Noalias_Attribute (V : GL_Value; Idx : Integer) is
+   begin
+      Add_SPARK_Noalias_Attribute (+V, unsigned (Idx));
+   end Add_SPARK_Noalias_Attribute;
+
+   ---------------------------
+   -- Set_Stack_Usage_Label --
+   ---------------------------
+
+   procedure Set_Stack_Usage_Label (V : GL_Value; Label : String) is
+   begin
+      Set_Stack_Usage_Label (+V, Label);
+   end Set_Stack_Usage_Label;
+
    -----------------------------
    -- Add_Nocapture_Attribute --
    -----------------------------
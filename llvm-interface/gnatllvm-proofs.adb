@@ -0,0 +1,160 @@
+------------------------------------------------------------------------------
+--                             G N A T - L L V M                            --
+--                                                                          --
+--                     Copyright (C) 2013-2023, AdaCore                     --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.  You should have  received  a copy of the GNU --
+-- General  Public  License  distributed  with  this  software;   see  file --
+-- COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy --
+-- of the license.                                                          --
+------------------------------------------------------------------------------
+
+with Ada.Directories;
+with Ada.Streams; use Ada.Streams;
+
+with GNAT.SHA1;
+
+with System.OS_Lib; use System.OS_Lib;
+
+with Errout; use Errout;
+with Lib;    use Lib;
+with Sinput; use Sinput;
+
+with GNATLLVM.Codegen; use GNATLLVM.Codegen;
+with GNATLLVM.Wrapper; use GNATLLVM.Wrapper;
+
+package body GNATLLVM.Proofs is
+
+   Have_Proof_Results : Boolean := False;
+   --  True if we've read proof results that are up to date
+
+   function Rule_Name (Kind : RT_Exception_Code) return String is
+     (case Kind is
+        when CE_Range_Check_Failed         => "VC_RANGE_CHECK",
+        when CE_Overflow_Check_Failed      => "VC_OVERFLOW_CHECK",
+        when CE_Index_Check_Failed         => "VC_INDEX_CHECK",
+        when CE_Discriminant_Check_Failed  => "VC_DISCRIMINANT_CHECK",
+        when others                        => "");
+   --  The name of the VC kind that gnat2why uses for a check raising Kind,
+   --  or "" if we don't use proof results for those checks.
+
+   function File_Digest (Name : String) return String;
+   --  Return the SHA-1 digest, in hexadecimal, of the contents of the file
+   --  Name, or "" if we can't read it.
+
+   -----------------
+   -- File_Digest --
+   -----------------
+
+   function File_Digest (Name : String) return String is
+      FD     : constant File_Descriptor := Open_Read (Name, Binary);
+      C      : GNAT.SHA1.Context        := GNAT.SHA1.Initial_Context;
+      Buffer : Stream_Element_Array (1 .. 65_536);
+      Last   : Integer;
+
+   begin
+      if FD = Invalid_FD then
+         return "";
+      end if;
+
+      loop
+         Last := Read (FD, Buffer'Address, Buffer'Length);
+         exit when Last <= 0;
+         GNAT.SHA1.Update (C, Buffer (1 .. Stream_Element_Offset (Last)));
+      end loop;
+
+      Close (FD);
+      return (if Last < 0 then "" else GNAT.SHA1.Digest (C));
+   end File_Digest;
+
+   ----------------
+   -- Initialize --
+   ----------------
+
+   procedure Initialize (GNAT_Root : N_Compilation_Unit_Id) is
+      Unit_File : constant String :=
+        Get_Name_String (Unit_File_Name (Main_Unit));
+      S         : constant String :=
+        (if   Proof_Results_Dir = null then ""
+         else Proof_Results_Dir.all & Directory_Separator &
+              Ada.Directories.Base_Name (Unit_File) & ".spark");
+      Err_Msg   : aliased Ptr_Err_Msg_Type;
+      Stale     : Boolean := False;
+
+   begin
+      if Proof_Results_Dir = null or else Emit_C then
+         return;
+      elsif not Is_Regular_File (S) then
+         Error_Msg_N ("??no proof results in `" & S & "`, keeping all checks",
+                      GNAT_Root);
+         return;
+      elsif Read_Proof_Results (S, Err_Msg'Address) then
+         Error_Msg_N ("could not read `" & S & "`: " &
+                        Get_LLVM_Error_Msg (Err_Msg), GNAT_Root);
+         return;
+      end if;
+
+      --  The results are stale if the main source file wasn't analyzed
+      --  or if any source file we have in common with the analysis has
+      --  changed since. We compare the exact contents of the files, since
+      --  even a change to a comment or a blank line moves the locations by
+      --  which the results identify checks.
+
+      for SFI in 1 .. Last_Source_File loop
+         if Instantiation (SFI) = No_Location then
+            declare
+               File   : constant String := Get_Name_String (File_Name (SFI));
+               Digest : constant String := Get_Proof_Source_Digest (File);
+
+            begin
+               if Digest /= "" then
+                  Stale := Stale
+                    or else Digest
+                            /= File_Digest
+                                 (Get_Name_String (Full_File_Name (SFI)));
+               elsif SFI = Our_Source_File then
+                  Stale := True;
+               end if;
+            end;
+         end if;
+      end loop;
+
+      if Stale then
+         Discard_Proof_Results;
+         Error_Msg_N ("??proof results in `" & S & "` are out of date, " &
+                        "keeping all checks", GNAT_Root);
+      else
+         Have_Proof_Results := True;
+      end if;
+   end Initialize;
+
+   ---------------
+   -- Is_Proved --
+   ---------------
+
+   function Is_Proved (N : Node_Id; Kind : RT_Exception_Code) return Boolean
+   is
+      S    : constant Source_Ptr        := Sloc (N);
+      Rule : constant String            := Rule_Name (Kind);
+      SFI  : constant Source_File_Index :=
+        (if S > No_Location then Get_Source_File_Index (S)
+         else No_Source_File);
+
+   begin
+      return Have_Proof_Results
+        and then Rule /= ""
+        and then SFI /= No_Source_File
+        and then Instantiation (SFI) = No_Location
+        and then Is_Check_Proved
+                   (Get_Name_String (File_Name (SFI)),
+                    Nat (Get_Logical_Line_Number (S)),
+                    Nat (Get_Column_Number (S)), Rule);
+   end Is_Proved;
+
+end GNATLLVM.Proofs;
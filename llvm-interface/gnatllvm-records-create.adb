@@ -22,9 +22,12 @@ with Errout;     use Errout;
 with Exp_Util;   use Exp_Util;
 with Get_Targ;   use Get_Targ;
 with Nlists;     use Nlists;
+with Output;     use Output;
 with Repinfo;    use Repinfo;
 with Sem_Aux;    use Sem_Aux;
 with Sem_Eval;   use Sem_Eval;
+with Sem_Util;   use Sem_Util;
+with Sinput;     use Sinput;
 with Snames;     use Snames;
 with Sprint;     use Sprint;
 with Table;      use Table;
@@ -476,6 +479,9 @@ package body GNATLLVM.Records.Create is
       Cur_RI_Pos     : ULL                      := 0;
       --  Current position into this RI
 
+      Bits_Saved     : ULL                      := 0;
+      --  Padding, in bits, that we removed by sorting fields by alignment
+
       Par_Depth      : Int                      := 0;
       --  Nesting depth into parent records
 
@@ -1285,6 +1291,17 @@ package body GNATLLVM.Records.Create is
          --  aliased field but we must have the same ordering in
          --  extensions.
 
+         Sort_By_Align          : constant Boolean   :=
+           Reorder and then Reorder_Components and then not Full_Access
+           and then not Has_Record_Rep_Clause (BT)
+           and then not In_Predefined_Unit (BT);
+         --  Says that we should also put fields with stricter alignment
+         --  first, which minimizes the padding between them. This changes
+         --  the layout of the record, and hence the ABI, so all units of a
+         --  program must be compiled the same way. We never do this for
+         --  types of the predefined units since the run-time library is
+         --  compiled without it.
+
          In_Variant             : constant Boolean   :=
            Variant_Stack.Last /= 0;
          --  True if we're processing inside a variant, either static
@@ -1342,6 +1359,12 @@ package body GNATLLVM.Records.Create is
          procedure Swap_Fields (L, R : Int);
          --  Swap the fields in Added_Fields with the above indices
 
+         function Laid_Out_Size return ULL;
+         --  Return the size, in bits, of the fields in Added_Fields if laid
+         --  out in their current order with just the padding needed to
+         --  align each of them, or zero if some field doesn't have a fixed
+         --  size or is to be packed or positioned.
+
          procedure Sort is new Ada.Containers.Generic_Sort
            (Index_Type => Int, Before => Field_Before, Swap => Swap_Fields);
 
@@ -1476,6 +1499,10 @@ package body GNATLLVM.Records.Create is
               (Pack_L = Bit and then RM_Size (Left_GT)  mod BPU /= 0);
             Bit_R     : constant Boolean              :=
               (Pack_R = Bit and then RM_Size (Right_GT) mod BPU /= 0);
+            Align_L   : constant Nat                  :=
+              (if Sort_By_Align then Get_Type_Alignment (Left_GT) else 0);
+            Align_R   : constant Nat                  :=
+              (if Sort_By_Align then Get_Type_Alignment (Right_GT) else 0);
 
          begin
             --  This function must satisfy the conditions of A.18(5/3),
@@ -1555,6 +1582,11 @@ package body GNATLLVM.Records.Create is
             elsif Reorder and then not Bit_L and then Bit_R then
                return True;
 
+            --  If asked to, fields with stricter alignment come first
+
+            elsif Sort_By_Align and then Align_L /= Align_R then
+               return Align_L > Align_R;
+
             --  Otherwise, keep the original sequence intact
 
             else
@@ -1574,6 +1606,39 @@ package body GNATLLVM.Records.Create is
             Added_Fields.Table (R) := Temp;
          end Swap_Fields;
 
+         -------------------
+         -- Laid_Out_Size --
+         -------------------
+
+         function Laid_Out_Size return ULL is
+            Pos       : ULL := 0;
+            Max_Align : Nat := BPU;
+
+         begin
+            for J in 1 .. Added_Fields.Last loop
+               declare
+                  AF    : constant Added_Field := Added_Fields.Table (J);
+                  GT    : constant GL_Type     := Full_GL_Type (AF.AF);
+                  Align : constant Nat         := Get_Type_Alignment (GT);
+
+               begin
+                  if Present (AF.Pos) or else Present (AF.Size)
+                    or else Field_Pack_Kind (AF.AF) /= None
+                    or else Is_Dynamic_Size (GT)
+                    or else Is_Nonnative_Type (GT)
+                  then
+                     return 0;
+                  end if;
+
+                  Pos       := Align_Pos (Pos, Align) +
+                                 Get_Type_Size (Type_Of (GT));
+                  Max_Align := Nat'Max (Max_Align, Align);
+               end;
+            end loop;
+
+            return Align_Pos (Pos, Max_Align);
+         end Laid_Out_Size;
+
          ----------------------------
          -- Fits_In_Bitfield_Field --
          ----------------------------
@@ -1716,9 +1781,25 @@ package body GNATLLVM.Records.Create is
             Move_Aliased_Fields;
          end if;
 
-         --  Then do any other required sorting
+         --  Then do any other required sorting, noting how much padding
+         --  that saves if we're sorting by alignment and asked to report.
+
+         if Sort_By_Align and then Reorder_Components_Report then
+            declare
+               Old_Size : constant ULL := Laid_Out_Size;
+               New_Size : ULL;
+
+            begin
+               Sort (1, Added_Fields.Last);
+               New_Size := Laid_Out_Size;
 
-         Sort (1, Added_Fields.Last);
+               if Old_Size > New_Size then
+                  Bits_Saved := Bits_Saved + (Old_Size - New_Size);
+               end if;
+            end;
+         else
+            Sort (1, Added_Fields.Last);
+         end if;
 
          --  If we're just elaborating types and this is a tagged record,
          --  we have to allow for the tag field because the front end
@@ -2053,6 +2134,26 @@ package body GNATLLVM.Records.Create is
       Add_Fields (TE);
       Process_Fields_To_Add;
 
+      --  Report the padding that we saved by sorting fields by alignment
+      --  for record types of the unit being compiled, once per type.
+
+      if Bits_Saved >= UBPU and then TE = BT
+        and then In_Extended_Main_Source_Unit (TE)
+      then
+         Write_Str (Get_Name_String (Debug_Source_Name
+                                       (Get_Source_File_Index (Sloc (TE)))));
+         Write_Char (':');
+         Write_Int (Int (Get_Logical_Line_Number (Sloc (TE))));
+         Write_Char (':');
+         Write_Int (Int (Get_Column_Number (Sloc (TE))));
+         Write_Str (": record ");
+         Write_Str (Get_Name_String (Chars (TE)));
+         Write_Str (": reordering components saved ");
+         Write_Int (Int (Bits_Saved / UBPU));
+         Write_Str (" bytes");
+         Write_Eol;
+      end if;
+
       --  If we haven't yet made any record info entries, it means that
       --  this is a fixed-size record that can be just an LLVM type,
       --  so use the one we made.
@@ -22,13 +22,16 @@ with Exp_Util;    use Exp_Util;
 with Get_Targ;    use Get_Targ;
 with Lib;         use Lib;
 with Nlists;      use Nlists;
+with Opt;
 with Restrict;    use Restrict;
 with Rident;      use Rident;
 with Sem_Aux;     use Sem_Aux;
 with Sem_Mech;    use Sem_Mech;
+with Sem_Prag;    use Sem_Prag;
 with Sem_Util;    use Sem_Util;
 with Sinput;      use Sinput;
 with Snames;      use Snames;
+with Stand;       use Stand;
 with Table;       use Table;
 with Targparm;    use Targparm;
 
@@ -139,6 +142,10 @@ package body GNATLLVM.Subprograms is
      with Pre => Present (GT);
    --  Return the Relationship for a parameter of type GT and kind PK
 
+   function Stack_Usage_Label (E : Subprogram_Kind_Id) return String;
+   --  Return the string identifying E in the stack usage report: its
+   --  location and qualified Ada name, as in the .su files of GCC.
+
    function Make_Trampoline
      (GT : GL_Type; Fn, Static_Link : GL_Value; N : Node_Id) return GL_Value
      with Pre  => Present (GT) and then Present (Fn)
@@ -2706,6 +2713,43 @@ package body GNATLLVM.Subprograms is
       return Get_Value (E);
    end Emit_Subprogram_Decl;
 
+   -----------------------
+   -- Stack_Usage_Label --
+   -----------------------
+
+   function Stack_Usage_Label (E : Subprogram_Kind_Id) return String is
+      SFI : constant Source_File_Index := Get_Source_File_Index (Sloc (E));
+
+      function Img (N : Nat) return String is
+        (Nat'Image (N) (2 .. Nat'Image (N)'Last));
+      --  Image of N without the leading space
+
+      function Qualified_Name (Id : Entity_Id) return String;
+      --  Return the name of Id, prefixed by those of its enclosing scopes
+
+      --------------------
+      -- Qualified_Name --
+      --------------------
+
+      function Qualified_Name (Id : Entity_Id) return String is
+      begin
+         Get_Decoded_Name_String (Chars (Id));
+
+         declare
+            Name : constant String := Name_Buffer (1 .. Name_Len);
+
+         begin
+            return (if   No (Scope (Id)) or else Scope (Id) = Standard_Standard
+                    then Name else Qualified_Name (Scope (Id)) & "." & Name);
+         end;
+      end Qualified_Name;
+
+   begin
+      return Get_Name_String (Debug_Source_Name (SFI)) & ":" &
+        Img (Nat (Get_Logical_Line_Number (Sloc (E)))) & ":" &
+        Img (Nat (Get_Column_Number (Sloc (E)))) & ":" & Qualified_Name (E);
+   end Stack_Usage_Label;
+
    ------------------------
    --  Create_Subprogram --
    ------------------------
@@ -2731,6 +2775,37 @@ package body GNATLLVM.Subprograms is
       UID         : constant Unique_Id   := New_Unique_Id;
       Formal      : Opt_Formal_Kind_Id;
 
+      function Has_SPARK_Mode_On (Id : Entity_Id) return Boolean is
+        (Present (SPARK_Pragma (Id))
+         and then Get_SPARK_Mode_From_Annotation (SPARK_Pragma (Id))
+                  = Opt.On);
+      --  True if Id is subject to SPARK_Mode On
+
+      function SPARK_No_Alias return Boolean;
+      --  True if we can rely on SPARK's guarantee (SPARK RM 6.4.2) that no
+      --  parameter of E that's written overlaps another parameter or an
+      --  object that E otherwise accesses. This requires both the spec and
+      --  body of E, if we can see it, to be in SPARK. SPARK checks this at
+      --  each call, so it's only valid if the callers are in SPARK too,
+      --  which is why the user has to ask for it.
+
+      --------------------
+      -- SPARK_No_Alias --
+      --------------------
+
+      function SPARK_No_Alias return Boolean is
+         Decl : constant Node_Id := Unit_Declaration_Node (E);
+
+      begin
+         return SPARK_Noalias and then not Is_Imported
+           and then Has_SPARK_Mode_On (E)
+           and then (Nkind (Decl) /= N_Subprogram_Declaration
+                     or else No (Corresponding_Body (Decl))
+                     or else Has_SPARK_Mode_On (Corresponding_Body (Decl)));
+      end SPARK_No_Alias;
+
+      Use_SPARK   : constant Boolean     := SPARK_No_Alias;
+
    begin
       Check_Convention (E);
 
@@ -2762,6 +2837,10 @@ package body GNATLLVM.Subprograms is
          Process_Pragmas      (E, LLVM_Func);
          Set_Dup_Global_Value (E, LLVM_Func);
 
+         if Stack_Usage then
+            Set_Stack_Usage_Label (LLVM_Func, Stack_Usage_Label (E));
+         end if;
+
          --  Add function to the table of subprograms that we've created,
          --  so we can add it to the module.
 
@@ -2877,11 +2956,12 @@ package body GNATLLVM.Subprograms is
 
                   --  See RM 6.2(12) for a discussion of when parameters
                   --  can alias. If the mechanism is specified as being by
-                  --  reference, they can alias. Likewise if they're
-                  --  explicitly marked as aliased.
+                  --  reference, they can alias, unless SPARK says they
+                  --  can't. Likewise if they're explicitly marked as
+                  --  aliased.
 
                   if not Is_Aliased (Formal)
-                    and then not Is_By_Reference_Type (GT)
+                    and then (not Is_By_Reference_Type (GT) or else Use_SPARK)
                   then
                      Add_Noalias_Attribute         (LLVM_Func, Param_Num);
                   end if;
@@ -2904,6 +2984,16 @@ package body GNATLLVM.Subprograms is
                   end if;
                end if;
 
+               --  We can't mark a fat pointer as noalias, so we also mark each
+               --  reference parameter that SPARK says doesn't alias anything
+               --  else in a way that lets us tell LLVM that its data doesn't.
+
+               if Use_SPARK and then PK_Is_Reference (PK)
+                 and then not Is_Aliased (Formal)
+               then
+                  Add_SPARK_Noalias_Attribute (LLVM_Func, Param_Num);
+               end if;
+
                if PK_Is_In_Or_Ref (PK) then
                   C_Set_Parameter (UID, Nat (Param_Num), Formal);
                   Param_Num := Param_Num + 1;
@@ -494,6 +494,20 @@ package body GNATLLVM.Types.Create is
                end if;
             end if;
 
+            --  If this is a vector type, check that it's an array that we
+            --  can use as a vector and, if no alignment is specified,
+            --  align it like that vector, as GCC does.
+
+            if Is_Vector_Type (TE) and then Is_Constrained (TE) then
+               if Vector_Lanes (GT) not in 2 | 4 | 8 | 16 | 32 | 64 then
+                  Error_Msg_NE ("??vector_type attribute ignored for&",
+                                TE, TE);
+               elsif No (Align) and then Present (Size_GT) then
+                  Align := UI_Min (+Size_GT / BPU,
+                                   UI_From_Int (Get_Maximum_Alignment));
+               end if;
+            end if;
+
             --  Ensure the alignment is valid. Note that Align was
             --  previously measured in units of bytes, but is now measured
             --  in bits.
@@ -534,6 +534,41 @@ package body GNATLLVM.Utils is
 
    end Process_Pragmas;
 
+   ---------------------------
+   -- Has_Machine_Attribute --
+   ---------------------------
+
+   function Has_Machine_Attribute
+     (E : Entity_Id; Attr : String) return Boolean
+   is
+      N : Node_Id := First_Rep_Item (E);
+
+   begin
+      while Present (N) loop
+         if Nkind (N) = N_Pragma
+           and then Get_Pragma_Id (N) = Pragma_Machine_Attribute
+         then
+            declare
+               List : constant List_Id      :=
+                 Pragma_Argument_Associations (N);
+               Str  : constant N_Subexpr_Id :=
+                 Expression (Next (First (List)));
+
+            begin
+               String_To_Name_Buffer (Strval (Expr_Value_S (Str)));
+
+               if Name_Buffer (1 .. Name_Len) = Attr then
+                  return True;
+               end if;
+            end;
+         end if;
+
+         N := Next_Rep_Item (N);
+      end loop;
+
+      return False;
+   end Has_Machine_Attribute;
+
    --------------------------------
    -- Enclosing_Subprogram_Scope --
    --------------------------------
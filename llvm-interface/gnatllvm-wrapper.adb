@@ -282,6 +282,32 @@ package body GNATLLVM.Wrapper is
       return Has_Nest_Attribute (Func, Idx) /= 0;
    end Has_Nest_Attribute;
 
+   ---------------------------
+   -- Has_Noalias_Attribute --
+   ---------------------------
+
+   function Has_Noalias_Attribute
+     (Func : Value_T; Idx : unsigned) return Boolean
+   is
+      function Has_Noalias_Attribute
+        (Func : Value_T; Idx : unsigned) return LLVM_Bool
+        with Import, Convention => C, External_Name => "Has_Noalias_Attribute";
+   begin
+      return Has_Noalias_Attribute (Func, Idx) /= 0;
+   end Has_Noalias_Attribute;
+
+   ----------------------------
+   -- Has_Readonly_Attribute --
+   ----------------------------
+
+   function Has_Readonly_Attribute (Func : Value_T) return Boolean is
+      function Has_Fn_Readonly_Attribute (Func : Value_T) return LLVM_Bool
+        with Import, Convention => C,
+             External_Name => "Has_Fn_Readonly_Attribute";
+   begin
+      return Has_Fn_Readonly_Attribute (Func) /= 0;
+   end Has_Readonly_Attribute;
+
    -------------------------
    -- Call_Param_Has_Nest --
    -------------------------
@@ -360,6 +386,12 @@ package body GNATLLVM.Wrapper is
       San_Cov_Allow_List       : String_Access;
       San_Cov_Ignore_List      : String_Access;
       Pass_Plugin_Name         : String_Access;
+      Profile_Gen_File         : String_Access;
+      Profile_Use_File         : String_Access;
+      Sample_Profile_File      : String_Access;
+      Time_Report              : Boolean;
+      Opt_Remarks              : Boolean;
+      Opt_Remarks_Passes       : String_Access;
       Error_Message            : System.Address) return Boolean
    is
       function Maybe_To_C (S : String_Access) return chars_ptr
@@ -383,6 +415,12 @@ package body GNATLLVM.Wrapper is
          San_Cov_Allow_List       : chars_ptr;
          San_Cov_Ignore_List      : chars_ptr;
          Pass_Plugin_Name         : chars_ptr;
+         Profile_Gen_File         : chars_ptr;
+         Profile_Use_File         : chars_ptr;
+         Sample_Profile_File      : chars_ptr;
+         Time_Report              : LLVM_Bool;
+         Opt_Remarks              : LLVM_Bool;
+         Opt_Remarks_Passes       : chars_ptr;
          Error_Message            : System.Address) return LLVM_Bool
         with Import, Convention => C, External_Name => "LLVM_Optimize_Module";
       Need_Loop_Info_B : constant LLVM_Bool := Boolean'Pos (Need_Loop_Info);
@@ -399,11 +437,19 @@ package body GNATLLVM.Wrapper is
       Fuzzer_B         : constant LLVM_Bool := Boolean'Pos (Enable_Fuzzer);
       ASan_B           : constant LLVM_Bool :=
         Boolean'Pos (Enable_Address_Sanitizer);
+      Time_Report_B    : constant LLVM_Bool := Boolean'Pos (Time_Report);
+      Opt_Remarks_B    : constant LLVM_Bool := Boolean'Pos (Opt_Remarks);
       Pass_PN_Ptr      : chars_ptr          := Maybe_To_C (Pass_Plugin_Name);
       Allow_List_Ptr   : chars_ptr          :=
         Maybe_To_C (San_Cov_Allow_List);
       Ignore_List_Ptr  : chars_ptr          :=
         Maybe_To_C (San_Cov_Ignore_List);
+      Prof_Gen_Ptr     : chars_ptr          := Maybe_To_C (Profile_Gen_File);
+      Prof_Use_Ptr     : chars_ptr          := Maybe_To_C (Profile_Use_File);
+      Sample_Prof_Ptr  : chars_ptr          :=
+        Maybe_To_C (Sample_Profile_File);
+      Remarks_Pass_Ptr : chars_ptr          :=
+        Maybe_To_C (Opt_Remarks_Passes);
       Result           : LLVM_Bool;
 
    begin
@@ -412,13 +458,313 @@ package body GNATLLVM.Wrapper is
           (Module, Target_Machine, Code_Opt_Level, Size_Opt_Level,
            Need_Loop_Info_B, No_Unroll_B, No_Loop_Vect_B, No_SLP_Vect_B,
            Merge_B, Thin_LTO_B, LTO_B, Reroll_B, Fuzzer_B, ASan_B,
-           Allow_List_Ptr, Ignore_List_Ptr, Pass_PN_Ptr, Error_Message);
+           Allow_List_Ptr, Ignore_List_Ptr, Pass_PN_Ptr, Prof_Gen_Ptr,
+           Prof_Use_Ptr, Sample_Prof_Ptr, Time_Report_B, Opt_Remarks_B,
+           Remarks_Pass_Ptr, Error_Message);
       Free (Allow_List_Ptr);
       Free (Ignore_List_Ptr);
       Free (Pass_PN_Ptr);
+      Free (Prof_Gen_Ptr);
+      Free (Prof_Use_Ptr);
+      Free (Sample_Prof_Ptr);
+      Free (Remarks_Pass_Ptr);
       return Result /= 0;
    end LLVM_Optimize_Module;
 
+   -----------------------------
+   -- Time_Report_Start_Phase --
+   -----------------------------
+
+   procedure Time_Report_Start_Phase (Name : String) is
+      procedure Time_Report_Start_Phase_C (Name : String)
+        with Import, Convention => C,
+             External_Name => "Time_Report_Start_Phase";
+   begin
+      Time_Report_Start_Phase_C (Name & ASCII.NUL);
+   end Time_Report_Start_Phase;
+
+   ---------------------------
+   -- Time_Report_End_Phase --
+   ---------------------------
+
+   procedure Time_Report_End_Phase (Name : String) is
+      procedure Time_Report_End_Phase_C (Name : String)
+        with Import, Convention => C,
+             External_Name => "Time_Report_End_Phase";
+   begin
+      Time_Report_End_Phase_C (Name & ASCII.NUL);
+   end Time_Report_End_Phase;
+
+   -----------------------
+   -- Write_Time_Report --
+   -----------------------
+
+   function Write_Time_Report
+     (Unit, File_Name : String; Error_Message : System.Address)
+     return Boolean
+   is
+      function Write_Time_Report_C
+        (Unit, File_Name : String;
+         Error_Message   : System.Address) return LLVM_Bool
+        with Import, Convention => C, External_Name => "Write_Time_Report";
+   begin
+      return Write_Time_Report_C (Unit & ASCII.NUL, File_Name & ASCII.NUL,
+                                  Error_Message) /= 0;
+   end Write_Time_Report;
+
+   --------------------------------
+   -- Write_Optimization_Remarks --
+   --------------------------------
+
+   function Write_Optimization_Remarks
+     (Module          : Module_T;
+      Unit, File_Name : String;
+      Error_Message   : System.Address) return Boolean
+   is
+      function Write_Optimization_Remarks_C
+        (Module          : Module_T;
+         Unit, File_Name : String;
+         Error_Message   : System.Address) return LLVM_Bool
+        with Import, Convention => C,
+             External_Name => "Write_Optimization_Remarks";
+   begin
+      return Write_Optimization_Remarks_C
+        (Module, Unit & ASCII.NUL, File_Name & ASCII.NUL, Error_Message) /= 0;
+   end Write_Optimization_Remarks;
+
+   ----------------------------
+   -- Set_Stack_Usage_Output --
+   ----------------------------
+
+   procedure Set_Stack_Usage_Output
+     (Target_Machine : Target_Machine_T; File_Name : String)
+   is
+      procedure Set_Stack_Usage_Output_C
+        (Target_Machine : Target_Machine_T; File_Name : String)
+        with Import, Convention => C,
+             External_Name => "Set_Stack_Usage_Output";
+   begin
+      Set_Stack_Usage_Output_C (Target_Machine, File_Name & ASCII.NUL);
+   end Set_Stack_Usage_Output;
+
+   ---------------------------
+   -- Set_Stack_Usage_Label --
+   ---------------------------
+
+   procedure Set_Stack_Usage_Label (Func : Value_T; Label : String) is
+      procedure Set_Stack_Usage_Label_C (Func : Value_T; Label : String)
+        with Import, Convention => C,
+             External_Name => "Set_Stack_Usage_Label";
+   begin
+      Set_Stack_Usage_Label_C (Func, Label & ASCII.NUL);
+   end Set_Stack_Usage_Label;
+
+   -----------------------
+   -- Write_Stack_Usage --
+   -----------------------
+
+   function Write_Stack_Usage
+     (Module         : Module_T;
+      Target_Machine : Target_Machine_T;
+      SU_File_Name   : String;
+      CI_File_Name   : String;
+      Error_Message  : System.Address) return Boolean
+   is
+      function Write_Stack_Usage_C
+        (Module         : Module_T;
+         Target_Machine : Target_Machine_T;
+         SU_File_Name   : String;
+         CI_File_Name   : String;
+         Error_Message  : System.Address) return LLVM_Bool
+        with Import, Convention => C, External_Name => "Write_Stack_Usage";
+   begin
+      return Write_Stack_Usage_C
+        (Module, Target_Machine, SU_File_Name & ASCII.NUL,
+         CI_File_Name & ASCII.NUL, Error_Message) /= 0;
+   end Write_Stack_Usage;
+
+   --------------------
+   -- Set_Check_Kind --
+   --------------------
+
+   procedure Set_Check_Kind (BB : Basic_Block_T; Kind : String) is
+      procedure Set_Check_Kind_C (BB : Basic_Block_T; Kind : String)
+        with Import, Convention => C, External_Name => "Set_Check_Kind";
+   begin
+      Set_Check_Kind_C (BB, Kind & ASCII.NUL);
+   end Set_Check_Kind;
+
+   -----------------------
+   -- Write_Check_Stats --
+   -----------------------
+
+   function Write_Check_Stats
+     (Module          : Module_T;
+      Unit, File_Name : String;
+      Error_Message   : System.Address) return Boolean
+   is
+      function Write_Check_Stats_C
+        (Module          : Module_T;
+         Unit, File_Name : String;
+         Error_Message   : System.Address) return LLVM_Bool
+        with Import, Convention => C, External_Name => "Write_Check_Stats";
+   begin
+      return Write_Check_Stats_C
+        (Module, Unit & ASCII.NUL, File_Name & ASCII.NUL, Error_Message) /= 0;
+   end Write_Check_Stats;
+
+   -----------------------
+   -- Write_LTO_Bitcode --
+   -----------------------
+
+   function Write_LTO_Bitcode
+     (Module         : Module_T;
+      Target_Machine : Target_Machine_T;
+      File_Name      : String;
+      Thin           : Boolean;
+      Error_Message  : System.Address) return Boolean
+   is
+      function Write_LTO_Bitcode_C
+        (Module         : Module_T;
+         Target_Machine : Target_Machine_T;
+         File_Name      : String;
+         Thin           : LLVM_Bool;
+         Error_Message  : System.Address) return LLVM_Bool
+        with Import, Convention => C, External_Name => "Write_LTO_Bitcode";
+   begin
+      return Write_LTO_Bitcode_C (Module, Target_Machine,
+                                  File_Name & ASCII.NUL, Boolean'Pos (Thin),
+                                  Error_Message) /= 0;
+   end Write_LTO_Bitcode;
+
+   ----------------------------------
+   -- Emit_Object_With_Split_DWARF --
+   ----------------------------------
+
+   function Emit_Object_With_Split_DWARF
+     (Module         : Module_T;
+      Target_Machine : Target_Machine_T;
+      File_Name      : String;
+      DWO_File_Name  : String;
+      Error_Message  : System.Address) return Boolean
+   is
+      function Emit_Object_With_Split_DWARF_C
+        (Module         : Module_T;
+         Target_Machine : Target_Machine_T;
+         File_Name      : String;
+         DWO_File_Name  : String;
+         Error_Message  : System.Address) return LLVM_Bool
+        with Import, Convention => C,
+             External_Name => "Emit_Object_With_Split_DWARF";
+   begin
+      return Emit_Object_With_Split_DWARF_C
+        (Module, Target_Machine, File_Name & ASCII.NUL,
+         DWO_File_Name & ASCII.NUL, Error_Message) /= 0;
+   end Emit_Object_With_Split_DWARF;
+
+   -----------------------
+   -- Emit_Split_Module --
+   -----------------------
+
+   function Emit_Split_Module
+     (Module         : Module_T;
+      Target_Machine : Target_Machine_T;
+      Parts          : Nat;
+      File_Name      : String;
+      Error_Message  : System.Address) return Boolean
+   is
+      function Emit_Split_Module_C
+        (Module         : Module_T;
+         Target_Machine : Target_Machine_T;
+         Parts          : unsigned;
+         File_Name      : String;
+         Error_Message  : System.Address) return LLVM_Bool
+        with Import, Convention => C, External_Name => "Emit_Split_Module";
+   begin
+      return Emit_Split_Module_C (Module, Target_Machine, unsigned (Parts),
+                                  File_Name & ASCII.NUL, Error_Message) /= 0;
+   end Emit_Split_Module;
+
+   -----------------------
+   -- Compile_Cache_Key --
+   -----------------------
+
+   function Compile_Cache_Key
+     (Module : Module_T; Options : String; Profile_File : String_Access)
+     return String
+   is
+      function Compile_Cache_Key_C
+        (Module : Module_T; Options : String; Profile_File : chars_ptr)
+        return chars_ptr
+        with Import, Convention => C, External_Name => "Compile_Cache_Key";
+
+      Profile_Ptr : chars_ptr :=
+        (if   Profile_File = null then Null_Ptr
+         else New_String (Profile_File.all));
+      Result_C    : chars_ptr :=
+        Compile_Cache_Key_C (Module, Options & ASCII.NUL, Profile_Ptr);
+      Result      : constant String :=
+        (if Result_C = Null_Ptr then "" else Value (Result_C));
+
+   begin
+      Free (Profile_Ptr);
+      Free (Result_C);
+      return Result;
+   end Compile_Cache_Key;
+
+   --------------------------
+   -- Compile_Cache_Lookup --
+   --------------------------
+
+   function Compile_Cache_Lookup (Dir, Key, Ext, Output : String)
+     return Boolean
+   is
+      function Compile_Cache_Lookup_C
+        (Dir, Key, Ext, Output : String) return LLVM_Bool
+        with Import, Convention => C,
+             External_Name => "Compile_Cache_Lookup";
+   begin
+      return Compile_Cache_Lookup_C (Dir & ASCII.NUL, Key & ASCII.NUL,
+                                     Ext & ASCII.NUL, Output & ASCII.NUL) /= 0;
+   end Compile_Cache_Lookup;
+
+   -------------------------
+   -- Compile_Cache_Store --
+   -------------------------
+
+   function Compile_Cache_Store
+     (Dir, Key, Ext, Output : String;
+      Max_Size              : ULL;
+      Error_Message         : System.Address) return Boolean
+   is
+      function Compile_Cache_Store_C
+        (Dir, Key, Ext, Output : String;
+         Max_Size              : ULL;
+         Error_Message         : System.Address) return LLVM_Bool
+        with Import, Convention => C, External_Name => "Compile_Cache_Store";
+   begin
+      return Compile_Cache_Store_C (Dir & ASCII.NUL, Key & ASCII.NUL,
+                                    Ext & ASCII.NUL, Output & ASCII.NUL,
+                                    Max_Size, Error_Message) /= 0;
+   end Compile_Cache_Store;
+
+   -------------------------
+   -- Compile_Cache_Stats --
+   -------------------------
+
+   procedure Compile_Cache_Stats (Dir : String; Hits, Misses : out Nat) is
+      procedure Compile_Cache_Stats_C
+        (Dir : String; Hits, Misses : out unsigned)
+        with Import, Convention => C, External_Name => "Compile_Cache_Stats";
+
+      C_Hits, C_Misses : unsigned;
+
+   begin
+      Compile_Cache_Stats_C (Dir & ASCII.NUL, C_Hits, C_Misses);
+      Hits   := Nat (C_Hits);
+      Misses := Nat (C_Misses);
+   end Compile_Cache_Stats;
+
    -----------------------------
    -- Get_GEP_Constant_Offset --
    -----------------------------
@@ -601,6 +947,18 @@ package body GNATLLVM.Wrapper is
       return Is_Dead_Basic_Block (BB) /= 0;
    end Is_Dead_Basic_Block;
 
+   --------------------
+   -- Is_Loop_Header --
+   --------------------
+
+   function Is_Loop_Header (BB : Basic_Block_T) return Boolean is
+      function Is_Loop_Header (BB : Basic_Block_T) return LLVM_Bool
+        with Import, Convention => C, External_Name => "Is_Loop_Header";
+
+   begin
+      return Is_Loop_Header (BB) /= 0;
+   end Is_Loop_Header;
+
    --------------------------
    -- Has_Default_PIE --
    --------------------------
@@ -623,6 +981,73 @@ package body GNATLLVM.Wrapper is
       return Has_SEH_C (Triple & ASCII.NUL) /= 0;
    end Has_SEH;
 
+   ---------------------------
+   -- Has_ELF_Object_Format --
+   ---------------------------
+
+   function Has_ELF_Object_Format (Triple : String) return Boolean is
+      function Has_ELF_Object_Format_C (Triple : String) return LLVM_Bool
+        with Import, Convention => C, External_Name => "Has_ELF_Object_Format";
+   begin
+      return Has_ELF_Object_Format_C (Triple & ASCII.NUL) /= 0;
+   end Has_ELF_Object_Format;
+
+   ------------------------
+   -- Run_Compile_Server --
+   ------------------------
+
+   function Run_Compile_Server (Socket : String) return Boolean is
+      function Run_Compile_Server_C (Socket : String) return int
+        with Import, Convention => C, External_Name => "Run_Compile_Server";
+   begin
+      return Run_Compile_Server_C (Socket & ASCII.NUL) = 0;
+   end Run_Compile_Server;
+
+   ------------------------
+   -- Read_Proof_Results --
+   ------------------------
+
+   function Read_Proof_Results
+     (File_Name : String; Error_Message : System.Address) return Boolean
+   is
+      function Read_Proof_Results_C
+        (File_Name : String; Error_Message : System.Address) return LLVM_Bool
+        with Import, Convention => C, External_Name => "Read_Proof_Results";
+   begin
+      return Read_Proof_Results_C (File_Name & ASCII.NUL, Error_Message) /= 0;
+   end Read_Proof_Results;
+
+   -----------------------------
+   -- Get_Proof_Source_Digest --
+   -----------------------------
+
+   function Get_Proof_Source_Digest (File : String) return String is
+      function Get_Proof_Source_Digest_C (File : String) return chars_ptr
+        with Import, Convention => C,
+             External_Name => "Get_Proof_Source_Digest";
+
+      Digest : constant chars_ptr :=
+        Get_Proof_Source_Digest_C (File & ASCII.NUL);
+
+   begin
+      return (if Digest = Null_Ptr then "" else Value (Digest));
+   end Get_Proof_Source_Digest;
+
+   ---------------------
+   -- Is_Check_Proved --
+   ---------------------
+
+   function Is_Check_Proved
+     (File : String; Line, Col : Nat; Rule : String) return Boolean
+   is
+      function Is_Check_Proved_C
+        (File : String; Line, Col : unsigned; Rule : String) return LLVM_Bool
+        with Import, Convention => C, External_Name => "Is_Check_Proved";
+   begin
+      return Is_Check_Proved_C (File & ASCII.NUL, unsigned (Line),
+                                unsigned (Col), Rule & ASCII.NUL) /= 0;
+   end Is_Check_Proved;
+
    -----------------------------------
    -- Get_Personality_Function_Name --
    -----------------------------------
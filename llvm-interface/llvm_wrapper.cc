@@ -1,4 +1,8 @@
+#include <limits.h>
 #include <string.h>
+#include <chrono>
+#include <map>
+#include <set>
 
 #include "llvm-c/Types.h"
 #include "llvm/ADT/APFloat.h"
@@ -7,37 +11,59 @@
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/Attributes.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/DiagnosticHandler.h"
+#include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/DIBuilder.h"
 #include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/GlobalValue.h"
 #include "llvm/IR/InlineAsm.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Metadata.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Passes/PassBuilder.h"
 #include "llvm/Passes/PassPlugin.h"
+#include "llvm/Passes/StandardInstrumentations.h"
 #include "llvm/Support/AArch64TargetParser.h"
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/Support/CachePruning.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/Regex.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
 #include "llvm/Transforms/Instrumentation/AddressSanitizer.h"
 #include "llvm/Transforms/Instrumentation/SanitizerCoverage.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/AlwaysInliner.h"
+#include "llvm/Transforms/IPO/ThinLTOBitcodeWriter.h"
 #include "llvm/Transforms/Scalar/LoopPassManager.h"
 #include "llvm/Transforms/Scalar/LoopRotation.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/SplitModule.h"
 #include "llvm-c/Core.h"
 
 #if LLVM_VERSION_MAJOR < 15
@@ -94,6 +120,39 @@ Add_Cold_Attribute (Function *fn)
   fn->addFnAttr (Attribute::Cold);
 }
 
+/* BB contains a call that raises an exception because a runtime check
+   failed.  Mark that call as cold and make the conditional branches to BB
+   unlikely to be taken.  The block placement then moves the raise out of
+   line and keeps the code for the check passing contiguous, even when the
+   call was inlined or the raise function isn't known to be cold.  */
+
+// The weight of the successful check relative to the failing one, which
+// is what __builtin_expect gives in clang.
+static const uint32_t Raise_Branch_Weight = 2000;
+
+extern "C"
+void
+Mark_Raise_Block_Cold (BasicBlock *BB)
+{
+  MDBuilder MDB (BB->getContext ());
+
+  for (Instruction &I : reverse (*BB))
+    if (auto *CB = dyn_cast<CallBase> (&I))
+      {
+	CB->addFnAttr (Attribute::Cold);
+	break;
+      }
+
+  for (BasicBlock *Pred : predecessors (BB))
+    if (auto *BI = dyn_cast_or_null<BranchInst> (Pred->getTerminator ()))
+      if (BI->isConditional () && BI->getSuccessor (0) != BI->getSuccessor (1)
+	  && !BI->getMetadata (LLVMContext::MD_prof))
+	BI->setMetadata (LLVMContext::MD_prof,
+			 BI->getSuccessor (0) == BB
+			 ? MDB.createBranchWeights (1, Raise_Branch_Weight)
+			 : MDB.createBranchWeights (Raise_Branch_Weight, 1));
+}
+
 extern "C"
 void
 Add_Dereferenceable_Attribute (Function *fn, unsigned idx,
@@ -267,6 +326,20 @@ Has_Nest_Attribute (Function *fn, unsigned idx)
   return fn->hasParamAttribute (idx, Attribute::Nest);
 }
 
+extern "C"
+bool
+Has_Noalias_Attribute (Function *fn, unsigned idx)
+{
+  return fn->hasParamAttribute (idx, Attribute::NoAlias);
+}
+
+extern "C"
+bool
+Has_Fn_Readonly_Attribute (Function *fn)
+{
+  return fn->onlyReadsMemory ();
+}
+
 extern "C"
 bool
 Call_Param_Has_Nest (CallBase *CI, unsigned idx)
@@ -587,8 +660,14 @@ Initialize_LLVM (void)
 {
   // Initialize the target registry etc.  These functions appear to be
   // in LLVM.Target, but they reference static inline function, so they
-  // can only be used from C, not Ada.
+  // can only be used from C, not Ada.  The compile server has already
+  // done this in the process from which ours was forked.
 
+  static bool Initialized = false;
+  if (Initialized)
+    return;
+
+  Initialized = true;
   InitializeAllTargetInfos ();
   InitializeAllTargets ();
   InitializeAllTargetMCs ();
@@ -614,11 +693,10 @@ struct Target_C_Type_Info {
   unsigned RegisterSize;
 };
 
-extern "C"
-void
-Get_Target_C_Types (const char *Triple, const char *CPU, const char *ABI,
-                    const char *Features, Target_C_Type_Info *Result,
-                    unsigned char *success)
+static void
+Compute_Target_C_Types (const char *Triple, const char *CPU, const char *ABI,
+                        const char *Features, Target_C_Type_Info *Result,
+                        unsigned char *success)
 {
   *Result = {};
   *success = 0;
@@ -676,11 +754,63 @@ Get_Target_C_Types (const char *Triple, const char *CPU, const char *ABI,
   *success = 1;
 }
 
+// Creating the Clang TargetInfo is a large part of the startup cost of the
+// compiler, so remember the results for each target.  This matters in the
+// compile server, where the results for its default target are computed
+// once before any compilation is forked.
+
+struct Target_C_Type_Result {
+  Target_C_Type_Info Info;
+  unsigned char success;
+};
+
+static std::map<std::string, Target_C_Type_Result> Target_C_Types_Cache;
+
+extern "C"
+void
+Get_Target_C_Types (const char *Triple, const char *CPU, const char *ABI,
+                    const char *Features, Target_C_Type_Info *Result,
+                    unsigned char *success)
+{
+  std::string Key = (Twine (Triple) + "\n" + CPU + "\n" + ABI + "\n"
+                     + Features).str ();
+  auto Found = Target_C_Types_Cache.find (Key);
+
+  if (Found == Target_C_Types_Cache.end ())
+    {
+      Target_C_Type_Result New;
+
+      Compute_Target_C_Types (Triple, CPU, ABI, Features, &New.Info,
+                              &New.success);
+      Found = Target_C_Types_Cache.emplace (Key, New).first;
+    }
+
+  *Result = Found->second.Info;
+  *success = Found->second.success;
+}
+
+/* Compute the C type information for a target ahead of its first use.  */
+
+extern "C"
+void
+Warm_Target_C_Types (const char *Triple, const char *CPU, const char *ABI,
+                     const char *Features)
+{
+  Target_C_Type_Info Info;
+  unsigned char success;
+
+  Get_Target_C_Types (Triple, CPU, ABI, Features, &Info, &success);
+}
+
 /* This is a dummy optimization "pass" that serves just to obtain loop
    information when generating C.
 
-   For now, we don't actually do anything except collect information to look
-   at in the debugger.  */
+   It runs last, so the loops it sees are those of the code we write.  We
+   record the header of each natural loop by tagging its terminator, which
+   is where the C generator looks for it.  Unlike a table of blocks, the
+   tag goes away with the block if the C generator deletes it.  */
+
+static const char *const Loop_Header_MD = "ccg.loop.header";
 
 namespace llvm
 {
@@ -702,15 +832,595 @@ PreservedAnalyses
 OurLoopPass::run (Loop &L, LoopAnalysisManager &LAM,
 		  LoopStandardAnalysisResults &AR, LPMUpdater &U)
 {
+  BasicBlock *Header = L.getHeader ();
+  LLVMContext &Ctx = Header->getContext ();
 
-  auto pre = L.getLoopPreheader ();
-  auto header = L.getHeader ();
-  auto latch = L.getLoopLatch ();
-  auto cmp = L.getLatchCmpInst ();
-  auto issimple = L.isLoopSimplifyForm ();
+  Header->getTerminator ()->setMetadata (Loop_Header_MD,
+					 MDNode::get (Ctx, {}));
   return PreservedAnalyses::all ();
 }
 
+/* Return whether BB is the header of a natural loop.  */
+
+extern "C"
+bool
+Is_Loop_Header (BasicBlock *BB)
+{
+  Instruction *T = BB->getTerminator ();
+
+  return T && T->getMetadata (Loop_Header_MD);
+}
+
+/* Support for -fspark-noalias.  The parameters of SPARK subprograms that
+   are marked with the "gnat-spark-noalias" attribute are those that SPARK
+   guarantees not to overlap each other or any object that the subprogram
+   otherwise accesses.  Some of these can't be marked noalias, such as the
+   fat pointers to unconstrained arrays, so we express the guarantee with
+   scoped alias metadata instead: each such parameter has its own scope and
+   each load or store whose address we know to be based on the parameter is
+   in that scope and doesn't alias the scopes of the other parameters.
+   Accesses that we know to be to some other identified object, such as a
+   local or global variable, don't alias any of them.  We leave alone any
+   access whose address we can't trace, since it may be to a parameter.
+
+   We run late in the function simplification pipeline so that the
+   parameters have been promoted out of their stack slots and the bodies of
+   any inlined callees are visible, but before the vectorizers.  */
+
+static const char *const SPARK_Noalias_Attribute = "gnat-spark-noalias";
+
+extern "C"
+void
+Add_SPARK_Noalias_Attribute (Function *fn, unsigned idx)
+{
+  fn->addParamAttr (idx, Attribute::get (fn->getContext (),
+					 SPARK_Noalias_Attribute));
+}
+
+namespace llvm
+{
+  struct SPARKNoaliasPass : PassInfoMixin<SPARKNoaliasPass>
+  {
+  public:
+    PreservedAnalyses run (Function &F, FunctionAnalysisManager &FAM);
+  };
+}
+
+/* Return the index in Params of the parameter that the memory designated
+   by Ptr is part of, -1 if it's part of some other identified object, and
+   -2 if we don't know.  The address of the data of a fat pointer is its
+   first field.  */
+
+static int
+SPARK_Param_Of (Value *Ptr, ArrayRef<Argument *> Params)
+{
+  const Value *Obj = getUnderlyingObject (Ptr, 0);
+
+  if (auto *EV = dyn_cast<ExtractValueInst> (Obj))
+    if (EV->getNumIndices () == 1 && EV->getIndices ()[0] == 0)
+      Obj = EV->getAggregateOperand ();
+
+  for (unsigned i = 0; i < Params.size (); i++)
+    if (Obj == Params[i])
+      return i;
+
+  return isIdentifiedObject (Obj) ? -1 : -2;
+}
+
+PreservedAnalyses
+SPARKNoaliasPass::run (Function &F, FunctionAnalysisManager &FAM)
+{
+  SmallVector<Argument *, 8> Params;
+
+  for (Argument &A : F.args ())
+    if (F.getAttributes ().hasParamAttr (A.getArgNo (),
+					 SPARK_Noalias_Attribute))
+      Params.push_back (&A);
+
+  if (Params.empty ())
+    return PreservedAnalyses::all ();
+
+  MDBuilder MDB (F.getContext ());
+  MDNode *Domain = MDB.createAnonymousAliasScopeDomain (F.getName ());
+  SmallVector<Metadata *, 8> Scopes;
+  bool Changed = false;
+
+  for (Argument *A : Params)
+    Scopes.push_back (MDB.createAnonymousAliasScope (Domain, A->getName ()));
+
+  for (Instruction &I : instructions (F))
+    {
+      SmallVector<Value *, 2> Ptrs;
+
+      if (auto *LI = dyn_cast<LoadInst> (&I))
+	Ptrs.push_back (LI->getPointerOperand ());
+      else if (auto *SI = dyn_cast<StoreInst> (&I))
+	Ptrs.push_back (SI->getPointerOperand ());
+      else if (auto *MI = dyn_cast<MemIntrinsic> (&I))
+	{
+	  Ptrs.push_back (MI->getRawDest ());
+	  if (auto *MTI = dyn_cast<MemTransferInst> (MI))
+	    Ptrs.push_back (MTI->getRawSource ());
+	}
+      else
+	continue;
+
+      /* Find which parameters this instruction accesses, giving up if
+	 we can't tell.  */
+
+      SmallVector<bool, 8> Accessed (Params.size (), false);
+      bool Known = true;
+
+      for (Value *Ptr : Ptrs)
+	{
+	  int Idx = SPARK_Param_Of (Ptr, Params);
+
+	  if (Idx == -2)
+	    Known = false;
+	  else if (Idx >= 0)
+	    Accessed[Idx] = true;
+	}
+
+      if (!Known)
+	continue;
+
+      SmallVector<Metadata *, 8> In_Scopes, Noalias_Scopes;
+
+      for (unsigned i = 0; i < Params.size (); i++)
+	(Accessed[i] ? In_Scopes : Noalias_Scopes).push_back (Scopes[i]);
+
+      if (!In_Scopes.empty ())
+	I.setMetadata (LLVMContext::MD_alias_scope,
+		       MDNode::concatenate
+		       (I.getMetadata (LLVMContext::MD_alias_scope),
+			MDNode::get (F.getContext (), In_Scopes)));
+      if (!Noalias_Scopes.empty ())
+	I.setMetadata (LLVMContext::MD_noalias,
+		       MDNode::concatenate
+		       (I.getMetadata (LLVMContext::MD_noalias),
+			MDNode::get (F.getContext (), Noalias_Scopes)));
+
+      Changed = true;
+    }
+
+  if (!Changed)
+    return PreservedAnalyses::all ();
+
+  PreservedAnalyses PA;
+  PA.preserveSet<CFGAnalyses> ();
+  return PA;
+}
+
+/* Support for -ftime-report.  We accumulate the time spent in each phase of
+   code generation, as named by GNAT-LLVM, and in each LLVM pass and
+   analysis.  Phases are timed inclusively.  Passes and analyses nest (a
+   function pass runs inside a module adaptor and may request analyses), so
+   we keep a stack of running timers and charge each interval only to the
+   innermost one, as LLVM's own TimePassesHandler does.  */
+
+struct Time_Report_Entry
+{
+  TimeRecord Time;
+  unsigned Count = 0;
+};
+
+struct Time_Report
+{
+  StringMap<Time_Report_Entry> Phases, Passes, Analyses;
+  StringMap<TimeRecord> Phase_Starts;
+  SmallVector<Time_Report_Entry *, 8> Running;
+  TimeRecord Last_Switch;
+
+  void start (Time_Report_Entry &E);
+  void stop ();
+};
+
+static Time_Report *The_Time_Report = nullptr;
+
+static Time_Report &
+Get_Time_Report ()
+{
+  if (The_Time_Report == nullptr)
+    The_Time_Report = new Time_Report ();
+
+  return *The_Time_Report;
+}
+
+/* Charge the time since the last switch to the innermost running timer and
+   make E the innermost one.  */
+
+void
+Time_Report::start (Time_Report_Entry &E)
+{
+  TimeRecord Now = TimeRecord::getCurrentTime (true);
+
+  if (!Running.empty ())
+    {
+      Now -= Last_Switch;
+      Running.back ()->Time += Now;
+    }
+
+  E.Count++;
+  Running.push_back (&E);
+  Last_Switch = TimeRecord::getCurrentTime (true);
+}
+
+/* Charge the time since the last switch to the innermost running timer and
+   resume the one that encloses it.  */
+
+void
+Time_Report::stop ()
+{
+  TimeRecord Now = TimeRecord::getCurrentTime (false);
+
+  if (Running.empty ())
+    return;
+
+  Now -= Last_Switch;
+  Running.back ()->Time += Now;
+  Running.pop_back ();
+  Last_Switch = TimeRecord::getCurrentTime (true);
+}
+
+extern "C"
+void
+Time_Report_Start_Phase (const char *Name)
+{
+  Time_Report &TR = Get_Time_Report ();
+
+  TR.Phases[Name].Count++;
+  TR.Phase_Starts[Name] = TimeRecord::getCurrentTime (true);
+}
+
+extern "C"
+void
+Time_Report_End_Phase (const char *Name)
+{
+  Time_Report &TR = Get_Time_Report ();
+  TimeRecord Now = TimeRecord::getCurrentTime (false);
+
+  Now -= TR.Phase_Starts[Name];
+  TR.Phases[Name].Time += Now;
+}
+
+/* Register callbacks on PIC to time each pass and analysis that's run.
+   Pass managers and adaptors only run other passes, so we don't time
+   them separately.  */
+
+static void
+Register_Time_Report_Callbacks (PassInstrumentationCallbacks &PIC)
+{
+  static const std::vector<StringRef> Specials
+    = {"PassManager", "PassAdaptor", "AnalysisManagerProxy",
+       "ModuleInlinerWrapperPass", "DevirtSCCRepeatedPass"};
+  Time_Report &TR = Get_Time_Report ();
+
+  PIC.registerBeforeNonSkippedPassCallback (
+      [&TR] (StringRef P, Any) {
+	if (!isSpecialPass (P, Specials))
+	  TR.start (TR.Passes[P]);
+      });
+  PIC.registerAfterPassCallback (
+      [&TR] (StringRef P, Any, const PreservedAnalyses &) {
+	if (!isSpecialPass (P, Specials))
+	  TR.stop ();
+      });
+  PIC.registerAfterPassInvalidatedCallback (
+      [&TR] (StringRef P, const PreservedAnalyses &) {
+	if (!isSpecialPass (P, Specials))
+	  TR.stop ();
+      });
+  PIC.registerBeforeAnalysisCallback (
+      [&TR] (StringRef P, Any) { TR.start (TR.Analyses[P]); });
+  PIC.registerAfterAnalysisCallback (
+      [&TR] (StringRef P, Any) { TR.stop (); });
+}
+
+/* Write one JSON array of timers, sorted so that the most expensive ones
+   come first.  */
+
+static void
+Write_Time_Report_Entries (json::OStream &J, StringRef Key,
+			   StringMap<Time_Report_Entry> &Entries)
+{
+  std::vector<StringMapEntry<Time_Report_Entry> *> Sorted;
+
+  for (auto &E : Entries)
+    Sorted.push_back (&E);
+
+  llvm::sort (Sorted, [] (auto *L, auto *R) {
+    if (L->second.Time.getWallTime () != R->second.Time.getWallTime ())
+      return L->second.Time.getWallTime () > R->second.Time.getWallTime ();
+    return L->first () < R->first ();
+  });
+
+  J.attributeArray (Key, [&] {
+    for (auto *E : Sorted)
+      J.object ([&] {
+	J.attribute ("name", E->first ());
+	J.attribute ("count", (int64_t) E->second.Count);
+	J.attribute ("wall", E->second.Time.getWallTime ());
+	J.attribute ("user", E->second.Time.getUserTime ());
+	J.attribute ("system", E->second.Time.getSystemTime ());
+      });
+  });
+}
+
+/* Write the times we've collected for Unit as JSON into FileName and
+   discard them.  Return nonzero on error.  */
+
+extern "C"
+LLVMBool
+Write_Time_Report (const char *Unit, const char *FileName,
+		   char **ErrorMessage)
+{
+  Time_Report &TR = Get_Time_Report ();
+  std::error_code EC;
+  raw_fd_ostream OS (FileName, EC, fs::OF_Text);
+
+  if (EC)
+    {
+      *ErrorMessage = strdup (EC.message ().c_str ());
+      return 1;
+    }
+
+  json::OStream J (OS, 2);
+  J.object ([&] {
+    J.attribute ("unit", Unit);
+    Write_Time_Report_Entries (J, "phases", TR.Phases);
+    Write_Time_Report_Entries (J, "passes", TR.Passes);
+    Write_Time_Report_Entries (J, "analyses", TR.Analyses);
+  });
+  OS << "\n";
+
+  delete The_Time_Report;
+  The_Time_Report = nullptr;
+  return 0;
+}
+
+/* Build the PGO options for profile file FileName and action Action.  The
+   constructor gained memory profile and file system arguments in LLVM 17.  */
+
+static PGOOptions
+Make_PGO_Options (const char *FileName, PGOOptions::PGOAction Action,
+		  bool DebugInfoForProfiling)
+{
+#if LLVM_VERSION_MAJOR < 17
+  return PGOOptions (FileName, "", "", Action, PGOOptions::NoCSAction,
+		     DebugInfoForProfiling);
+#else
+  return PGOOptions (FileName, "", "", "", vfs::getRealFileSystem (), Action,
+		     PGOOptions::NoCSAction, DebugInfoForProfiling);
+#endif
+}
+
+/* Optimization remarks.  When they're requested, we collect the remarks
+   emitted by the optimizer and the code generator through a diagnostic
+   handler on the context instead of letting LLVM print them.  Each remark
+   is located by the debug location of the instruction it's about, which
+   is the Ada source location set by Set_Debug_Pos_At_Node.  */
+
+struct Opt_Remark
+{
+  std::string Kind, Pass, Name, Message, File, Subprogram;
+  unsigned Line = 0, Column = 0;
+  std::optional<uint64_t> Hotness;
+};
+
+struct Opt_Remark_Handler : public DiagnosticHandler
+{
+  std::optional<Regex> Passes;
+  std::vector<Opt_Remark> Remarks;
+
+  bool isPassEnabled (StringRef PassName) const
+  {
+    return !Passes || Passes->match (PassName);
+  }
+  bool isAnalysisRemarkEnabled (StringRef PassName) const override
+  {
+    return isPassEnabled (PassName);
+  }
+  bool isMissedOptRemarkEnabled (StringRef PassName) const override
+  {
+    return isPassEnabled (PassName);
+  }
+  bool isPassedOptRemarkEnabled (StringRef PassName) const override
+  {
+    return isPassEnabled (PassName);
+  }
+  bool isAnyRemarkEnabled () const override
+  {
+    return true;
+  }
+  bool handleDiagnostics (const DiagnosticInfo &DI) override;
+};
+
+static Opt_Remark_Handler *The_Opt_Remark_Handler = nullptr;
+
+bool
+Opt_Remark_Handler::handleDiagnostics (const DiagnosticInfo &DI)
+{
+  // Let LLVM handle anything that isn't a remark as usual
+
+  auto *OR = dyn_cast<DiagnosticInfoOptimizationBase> (&DI);
+  if (!OR)
+    return false;
+
+  Opt_Remark R;
+  const Function &F = OR->getFunction ();
+  const DISubprogram *SP = F.getSubprogram ();
+
+  R.Kind = (OR->isPassed () ? "passed" : OR->isMissed () ? "missed"
+	    : "analysis");
+  R.Pass = OR->getPassName ().str ();
+  R.Name = OR->getRemarkName ().str ();
+  R.Message = OR->getMsg ();
+  R.Subprogram = (SP ? SP->getName () : F.getName ()).str ();
+  R.Hotness = OR->getHotness ();
+  if (OR->isLocationAvailable ())
+    {
+      DiagnosticLocation Loc = OR->getLocation ();
+
+      R.File = Loc.getRelativePath ().str ();
+      R.Line = Loc.getLine ();
+      R.Column = Loc.getColumn ();
+    }
+
+  Remarks.push_back (std::move (R));
+  return true;
+}
+
+/* Install a handler on Context that collects the remarks of the passes
+   whose name matches the regular expression Passes, or of all passes if
+   it's null.  If WantHotness, ask for the profile count of each remark.
+   Return nonzero on error.  */
+
+static LLVMBool
+Register_Opt_Remark_Handler (LLVMContext &Context, const char *Passes,
+			     bool WantHotness, char **ErrorMessage)
+{
+  auto Handler = std::make_unique<Opt_Remark_Handler> ();
+
+  if (Passes != nullptr)
+    {
+      Regex R (Passes);
+      std::string Error;
+
+      if (!R.isValid (Error))
+	{
+	  *ErrorMessage
+	    = strdup (("invalid optimization record passes: " + Error)
+		      .c_str ());
+	  return 1;
+	}
+
+      Handler->Passes = std::move (R);
+    }
+
+  The_Opt_Remark_Handler = Handler.get ();
+  Context.setDiagnosticHandler (std::move (Handler));
+  Context.setDiagnosticsHotnessRequested (WantHotness);
+  return 0;
+}
+
+/* Write the summary entry Key of the missed remarks of the passes Passes,
+   grouped by source location and ranked by profile count if we have one
+   and otherwise by number of remarks.  */
+
+static void
+Write_Missed_Opt_Summary (json::OStream &J, StringRef Key,
+			  ArrayRef<StringRef> Passes,
+			  const std::vector<Opt_Remark> &Remarks)
+{
+  struct Group
+  {
+    const Opt_Remark *First;
+    unsigned Count = 0;
+    uint64_t Hotness = 0;
+  };
+  std::map<std::tuple<std::string, unsigned, std::string>, Group> Groups;
+
+  for (const Opt_Remark &R : Remarks)
+    if (R.Kind == "missed" && is_contained (Passes, R.Pass))
+      {
+	Group &G = Groups[{R.File, R.Line, R.Subprogram}];
+
+	if (G.Count++ == 0)
+	  G.First = &R;
+	G.Hotness = std::max (G.Hotness, R.Hotness.value_or (0));
+      }
+
+  std::vector<const Group *> Sorted;
+  for (auto &G : Groups)
+    Sorted.push_back (&G.second);
+
+  llvm::stable_sort (Sorted, [] (const Group *L, const Group *R) {
+    if (L->Hotness != R->Hotness)
+      return L->Hotness > R->Hotness;
+    return L->Count > R->Count;
+  });
+
+  J.attributeArray (Key, [&] {
+    for (const Group *G : Sorted)
+      J.object ([&] {
+	J.attribute ("file", G->First->File);
+	J.attribute ("line", (int64_t) G->First->Line);
+	J.attribute ("subprogram", G->First->Subprogram);
+	J.attribute ("count", (int64_t) G->Count);
+	if (G->Hotness != 0)
+	  J.attribute ("hotness", (int64_t) G->Hotness);
+	J.attribute ("message", G->First->Message);
+      });
+  });
+}
+
+/* Write the remarks collected for Unit as JSON into FileName, sorted by
+   file, line and subprogram and followed by a summary of the missed
+   vectorization and inlining opportunities, and stop collecting them.
+   Return nonzero on error.  */
+
+extern "C"
+LLVMBool
+Write_Optimization_Remarks (Module *M, const char *Unit, const char *FileName,
+			    char **ErrorMessage)
+{
+  std::error_code EC;
+  raw_fd_ostream OS (FileName, EC, fs::OF_Text);
+
+  if (EC)
+    {
+      *ErrorMessage = strdup (EC.message ().c_str ());
+      return 1;
+    }
+
+  // If the optimizer didn't run, there are no remarks to write
+
+  std::vector<Opt_Remark> No_Remarks;
+  std::vector<Opt_Remark> &Remarks
+    = The_Opt_Remark_Handler ? The_Opt_Remark_Handler->Remarks : No_Remarks;
+
+  llvm::stable_sort (Remarks, [] (const Opt_Remark &L, const Opt_Remark &R) {
+    return (std::tie (L.File, L.Line, L.Subprogram, L.Column)
+	    < std::tie (R.File, R.Line, R.Subprogram, R.Column));
+  });
+
+  json::OStream J (OS, 2);
+  J.object ([&] {
+    J.attribute ("unit", Unit);
+    J.attributeArray ("remarks", [&] {
+      for (const Opt_Remark &R : Remarks)
+	J.object ([&] {
+	  J.attribute ("file", R.File);
+	  J.attribute ("line", (int64_t) R.Line);
+	  J.attribute ("column", (int64_t) R.Column);
+	  J.attribute ("subprogram", R.Subprogram);
+	  J.attribute ("kind", R.Kind);
+	  J.attribute ("pass", R.Pass);
+	  J.attribute ("name", R.Name);
+	  J.attribute ("message", R.Message);
+	  if (R.Hotness)
+	    J.attribute ("hotness", (int64_t) *R.Hotness);
+	});
+    });
+    J.attributeObject ("summary", [&] {
+      Write_Missed_Opt_Summary (J, "missed_vectorization",
+				{"loop-vectorize", "slp-vectorizer"},
+				Remarks);
+      Write_Missed_Opt_Summary (J, "missed_inlining", {"inline"}, Remarks);
+    });
+  });
+  OS << "\n";
+
+  if (The_Opt_Remark_Handler)
+    {
+      M->getContext ().setDiagnosticHandler
+	(std::make_unique<DiagnosticHandler> ());
+      The_Opt_Remark_Handler = nullptr;
+    }
+
+  return 0;
+}
+
 extern "C"
 LLVMBool
 LLVM_Optimize_Module (Module *M, TargetMachine *TM, int CodeOptLevel,
@@ -720,10 +1430,25 @@ LLVM_Optimize_Module (Module *M, TargetMachine *TM, int CodeOptLevel,
                       bool PrepareForLTO, bool RerollLoops, bool EnableFuzzer,
                       bool EnableAddressSanitizer, const char *SanCovAllowList,
                       const char *SanCovIgnoreList, const char *PassPluginName,
+                      const char *ProfileGenFile, const char *ProfileUseFile,
+                      const char *SampleProfileFile, bool TimeReport,
+                      bool OptRemarks, const char *OptRemarksPasses,
                       char **ErrorMessage) {
   // This code is derived from EmitAssemblyWithNewPassManager in clang
 
   std::optional<PGOOptions> PGOOpt;
+
+  // Set up profile-guided optimization the same way as clang: at most one
+  // of instrumentation, instrumentation-based use and sample-based use.
+  // Sample profiles are matched against line tables, so ask for the extra
+  // debug info that makes the matching precise.
+  if (ProfileGenFile != nullptr)
+    PGOOpt = Make_PGO_Options (ProfileGenFile, PGOOptions::IRInstr, false);
+  else if (ProfileUseFile != nullptr)
+    PGOOpt = Make_PGO_Options (ProfileUseFile, PGOOptions::IRUse, false);
+  else if (SampleProfileFile != nullptr)
+    PGOOpt = Make_PGO_Options (SampleProfileFile, PGOOptions::SampleUse, true);
+
   PipelineTuningOptions PTO;
   PassInstrumentationCallbacks PIC;
   Triple TargetTriple (M->getTargetTriple ());
@@ -743,6 +1468,16 @@ LLVM_Optimize_Module (Module *M, TargetMachine *TM, int CodeOptLevel,
   CGSCCAnalysisManager CGAM;
   ModuleAnalysisManager MAM;
 
+  if (TimeReport)
+    Register_Time_Report_Callbacks (PIC);
+
+  if (OptRemarks
+      && Register_Opt_Remark_Handler (M->getContext (), OptRemarksPasses,
+                                      PGOOpt.has_value ()
+                                      && ProfileGenFile == nullptr,
+                                      ErrorMessage))
+    return 1;
+
   PassBuilder PB (TM, PTO, PGOOpt, &PIC);
 
   if (PassPluginName != nullptr)
@@ -809,6 +1544,11 @@ LLVM_Optimize_Module (Module *M, TargetMachine *TM, int CodeOptLevel,
           MPM.addPass(AddressSanitizerPass(AddressSanitizerOptions()));
       });
 
+  PB.registerScalarOptimizerLateEPCallback(
+      [](FunctionPassManager &FPM, OptimizationLevel Level) {
+        FPM.addPass(SPARKNoaliasPass());
+      });
+
   ModulePassManager MPM;
   if (CodeOptLevel == 0)
     {
@@ -832,10 +1572,701 @@ LLVM_Optimize_Module (Module *M, TargetMachine *TM, int CodeOptLevel,
   return 0;
 }
 
+/* Write M, which has been optimized with the ThinLTO or full LTO pre-link
+   pipeline, as bitcode into FileName for the linker to optimize further.
+   As for clang, the bitcode for ThinLTO contains the module summary that
+   the thin link uses to decide what to import into each module; we use
+   LLVM's ThinLTO bitcode writer to compute it.  Return nonzero on
+   error.  */
+
 extern "C"
-Value *
-Get_Float_From_Words_And_Exp (LLVMContext *Context, Type *T, int Exp,
-			      unsigned NumWords, const uint64_t Words[])
+LLVMBool
+Write_LTO_Bitcode (Module *M, TargetMachine *TM, const char *FileName,
+		   bool Thin, char **ErrorMessage)
+{
+  std::error_code EC;
+  raw_fd_ostream OS (FileName, EC, fs::OF_None);
+
+  if (EC)
+    {
+      *ErrorMessage = strdup (EC.message ().c_str ());
+      return 1;
+    }
+
+  if (!Thin)
+    {
+      if (!M->getModuleFlag ("ThinLTO"))
+	M->addModuleFlag (Module::Error, "ThinLTO", uint32_t (0));
+
+      WriteBitcodeToFile (*M, OS);
+      return 0;
+    }
+
+  LoopAnalysisManager LAM;
+  FunctionAnalysisManager FAM;
+  CGSCCAnalysisManager CGAM;
+  ModuleAnalysisManager MAM;
+  PassBuilder PB (TM);
+  ModulePassManager MPM;
+
+  PB.registerModuleAnalyses (MAM);
+  PB.registerCGSCCAnalyses (CGAM);
+  PB.registerFunctionAnalyses (FAM);
+  PB.registerLoopAnalyses (LAM);
+  PB.crossRegisterProxies (LAM, FAM, CGAM, MAM);
+  MPM.addPass (ThinLTOBitcodeWriterPass (OS, nullptr));
+  MPM.run (*M, MAM);
+  return 0;
+}
+
+/* Generate an object file for M into FileName, putting most of the DWARF
+   debug information into the separate file DwoFileName, as for clang's
+   -gsplit-dwarf.  The object file only keeps a skeleton compile unit, with
+   the line tables and address ranges, that names the .dwo file, which the
+   linker doesn't need to read.  Return nonzero on error.  */
+
+extern "C"
+LLVMBool
+Emit_Object_With_Split_DWARF (Module *M, TargetMachine *TM,
+			      const char *FileName, const char *DwoFileName,
+			      char **ErrorMessage)
+{
+  if (!TM->getTargetTriple ().isOSBinFormatELF ())
+    {
+      *ErrorMessage = strdup ("split DWARF is only supported for ELF");
+      return 1;
+    }
+
+  std::error_code EC;
+  raw_fd_ostream OS (FileName, EC, fs::OF_None);
+
+  if (EC)
+    {
+      *ErrorMessage = strdup (EC.message ().c_str ());
+      return 1;
+    }
+
+  raw_fd_ostream DwoOS (DwoFileName, EC, fs::OF_None);
+
+  if (EC)
+    {
+      *ErrorMessage = strdup ((std::string (DwoFileName) + ": "
+			       + EC.message ()).c_str ());
+      return 1;
+    }
+
+  std::string Saved_Split_Dwarf_File = TM->Options.MCOptions.SplitDwarfFile;
+  legacy::PassManager PM;
+
+  TM->Options.MCOptions.SplitDwarfFile = DwoFileName;
+  if (TM->addPassesToEmitFile (PM, OS, &DwoOS, CGFT_ObjectFile))
+    {
+      TM->Options.MCOptions.SplitDwarfFile = Saved_Split_Dwarf_File;
+      *ErrorMessage = strdup ("target can't emit an object file");
+      return 1;
+    }
+
+  PM.run (*M);
+  TM->Options.MCOptions.SplitDwarfFile = Saved_Split_Dwarf_File;
+  return 0;
+}
+
+/* Split M into Parts partitions and generate an object file for each one in
+   parallel, writing partition I into FileName.I.  This is modeled on
+   splitCodeGen in LLVM's LTO backend: LLVM contexts can't be shared between
+   threads, so each partition is serialized to bitcode here and read back
+   into a fresh context by the thread that generates code for it, using its
+   own copy of TM.  M is modified by the split and should only be disposed of
+   afterwards.  Return nonzero on error.  */
+
+extern "C"
+LLVMBool
+Emit_Split_Module (Module *M, TargetMachine *TM, unsigned Parts,
+		   const char *FileName, char **ErrorMessage)
+{
+  SmallVector<SmallString<0>, 8> BCs;
+
+  SplitModule (*M, Parts, [&] (std::unique_ptr<Module> MPart) {
+    SmallString<0> BC;
+    raw_svector_ostream BCOS (BC);
+
+    WriteBitcodeToFile (*MPart, BCOS);
+    BCs.push_back (std::move (BC));
+  });
+
+  std::vector<std::string> Errors (BCs.size ());
+  ThreadPool Pool (hardware_concurrency (BCs.size ()));
+
+  for (unsigned i = 0; i < BCs.size (); i++)
+    Pool.async ([&, i] {
+      LLVMContext Ctx;
+      auto MOrErr
+	= parseBitcodeFile (MemoryBufferRef (BCs[i], "split-module"), Ctx);
+
+      if (!MOrErr)
+	{
+	  Errors[i] = toString (MOrErr.takeError ());
+	  return;
+	}
+
+      std::unique_ptr<TargetMachine> PartTM
+	(TM->getTarget ().createTargetMachine
+	 (TM->getTargetTriple ().str (), TM->getTargetCPU (),
+	  TM->getTargetFeatureString (), TM->Options,
+	  TM->getRelocationModel (), TM->getCodeModel (),
+	  TM->getOptLevel ()));
+      std::string PartName = std::string (FileName) + "." + utostr (i);
+      std::error_code EC;
+
+      /* Each piece writes its own stack usage file, which we append to
+	 the one of the whole module below, since the lines written by
+	 different threads to the same file could be interleaved.  */
+      if (!TM->Options.StackUsageOutput.empty ())
+	PartTM->Options.StackUsageOutput
+	  = TM->Options.StackUsageOutput + "." + utostr (i);
+      raw_fd_ostream OS (PartName, EC, fs::OF_None);
+
+      if (EC)
+	{
+	  Errors[i] = PartName + ": " + EC.message ();
+	  return;
+	}
+
+      legacy::PassManager PM;
+
+      if (PartTM->addPassesToEmitFile (PM, OS, nullptr, CGFT_ObjectFile))
+	{
+	  Errors[i] = "target can't emit an object file";
+	  return;
+	}
+
+      PM.run (**MOrErr);
+    });
+
+  Pool.wait ();
+
+  for (auto &Error : Errors)
+    if (!Error.empty ())
+      {
+	*ErrorMessage = strdup (Error.c_str ());
+	return 1;
+      }
+
+  if (!TM->Options.StackUsageOutput.empty ())
+    {
+      std::error_code EC;
+      raw_fd_ostream OS (TM->Options.StackUsageOutput, EC,
+			 fs::OF_Append | fs::OF_Text);
+
+      for (unsigned i = 0; i < BCs.size () && !EC; i++)
+	{
+	  std::string PartName
+	    = TM->Options.StackUsageOutput + "." + utostr (i);
+
+	  if (auto Buf = MemoryBuffer::getFile (PartName))
+	    OS << (*Buf)->getBuffer ();
+	  fs::remove (PartName);
+	}
+    }
+
+  return 0;
+}
+
+/* Support for -fstack-usage.  We have the AsmPrinter write the frame size
+   of each function into a raw file, which identifies functions by their
+   linker names, and then rewrite it into the .su file of the unit in the
+   same format as GCC, "FILE:LINE:COL:NAME<tab>SIZE<tab>QUALIFIERS", using
+   the location and Ada name of each subprogram given to us by GNAT-LLVM.
+   The qualifier is "dynamic" if the frame also has objects whose size is
+   only known at run time and "static" otherwise.
+
+   We also write the call information that a tool needs to combine the .su
+   files of a program into the worst-case stack usage of each task into a
+   .ci file.  Its lines are "node<tab>LINKER_NAME<tab>LABEL", where LABEL
+   is the part of the .su line before the first tab, "call<tab>CALLER<tab>
+   CALLEE" and "indirect<tab>CALLER", the latter if CALLER makes a call
+   we can't resolve.  */
+
+static std::map<std::string, std::string> Stack_Usage_Labels;
+
+extern "C"
+void
+Set_Stack_Usage_Output (TargetMachine *TM, const char *FileName)
+{
+  /* The AsmPrinter appends to the file.  */
+  fs::remove (FileName);
+  TM->Options.StackUsageOutput = FileName;
+}
+
+extern "C"
+void
+Set_Stack_Usage_Label (Function *F, const char *Label)
+{
+  Stack_Usage_Labels[F->getName ().str ()] = Label;
+}
+
+static std::string
+Stack_Usage_Label (StringRef Name)
+{
+  auto It = Stack_Usage_Labels.find (Name.str ());
+
+  return It == Stack_Usage_Labels.end () ? Name.str () : It->second;
+}
+
+/* Write the .su file SUFile from the raw file written during code
+   generation and the .ci file CIFile from M.  Return nonzero on error.  */
+
+extern "C"
+LLVMBool
+Write_Stack_Usage (Module *M, TargetMachine *TM, const char *SUFile,
+		   const char *CIFile, char **ErrorMessage)
+{
+  std::string RawFile = TM->Options.StackUsageOutput;
+  std::vector<std::string> Lines;
+  std::error_code EC;
+
+  TM->Options.StackUsageOutput.clear ();
+
+  /* There's no raw file if we had no functions to generate.  */
+  if (auto Buf = MemoryBuffer::getFile (RawFile))
+    {
+      SmallVector<StringRef, 64> RawLines;
+
+      (*Buf)->getBuffer ().split (RawLines, '\n', -1, false);
+      for (StringRef Line : RawLines)
+	{
+	  /* The linker name is the last field of the location, which is
+	     the part before the size.  */
+	  auto [Loc, Rest] = Line.split ('\t');
+	  StringRef Name = Loc.rsplit (':').second;
+
+	  Lines.push_back (Stack_Usage_Label (Name) + "\t" + Rest.str ());
+	}
+
+      fs::remove (RawFile);
+    }
+
+  llvm::sort (Lines);
+  raw_fd_ostream SU (SUFile, EC, fs::OF_Text);
+
+  if (EC)
+    {
+      *ErrorMessage = strdup (EC.message ().c_str ());
+      return 1;
+    }
+
+  for (auto &Line : Lines)
+    SU << Line << "\n";
+
+  raw_fd_ostream CI (CIFile, EC, fs::OF_Text);
+
+  if (EC)
+    {
+      *ErrorMessage = strdup ((std::string (CIFile) + ": "
+			       + EC.message ()).c_str ());
+      return 1;
+    }
+
+  for (Function &F : *M)
+    {
+      if (F.isDeclaration ())
+	continue;
+
+      std::set<StringRef> Callees;
+      bool Indirect = false;
+
+      for (Instruction &I : instructions (F))
+	if (auto *CB = dyn_cast<CallBase> (&I))
+	  {
+	    if (CB->isInlineAsm () || isa<IntrinsicInst> (CB))
+	      continue;
+	    else if (Function *Callee = CB->getCalledFunction ())
+	      Callees.insert (Callee->getName ());
+	    else
+	      Indirect = true;
+	  }
+
+      CI << "node\t" << F.getName () << "\t"
+	 << Stack_Usage_Label (F.getName ()) << "\n";
+      for (StringRef Callee : Callees)
+	CI << "call\t" << F.getName () << "\t" << Callee << "\n";
+      if (Indirect)
+	CI << "indirect\t" << F.getName () << "\n";
+    }
+
+  return 0;
+}
+
+/* Support for -fcheck-stats.  Each call that raises an exception for a
+   failed runtime check is tagged with the kind of the check, so that we
+   can count the checks of each subprogram before and after optimization
+   and report how many of them the optimizer removed.  The calls of a
+   check that a pass merged with another may lose their tag, so we fall
+   back to the name of the raise function, which gives the kind unless
+   it's the last chance handler.  */
+
+static std::map<std::pair<std::string, std::string>, unsigned> Emitted_Checks;
+
+extern "C"
+void
+Set_Check_Kind (BasicBlock *BB, const char *Kind)
+{
+  LLVMContext &Ctx = BB->getContext ();
+
+  for (Instruction &I : reverse (*BB))
+    if (isa<CallBase> (&I))
+      {
+	I.setMetadata ("gnat.check",
+		       MDNode::get (Ctx, MDString::get (Ctx, Kind)));
+	break;
+      }
+}
+
+/* Count the checks of each function of M by function name and kind.  A
+   raise block reached by several branches, for example because the
+   raises of several checks were merged, counts once per branch.  */
+
+static std::map<std::pair<std::string, std::string>, unsigned>
+Count_Checks (Module *M)
+{
+  std::map<std::pair<std::string, std::string>, unsigned> Counts;
+
+  for (Function &F : *M)
+    for (Instruction &I : instructions (F))
+      if (auto *CB = dyn_cast<CallBase> (&I))
+	{
+	  std::string Kind;
+	  Function *Callee = CB->getCalledFunction ();
+
+	  if (MDNode *MD = I.getMetadata ("gnat.check"))
+	    Kind = cast<MDString> (MD->getOperand (0))->getString ().str ();
+	  else if (Callee && Callee->getName ().startswith ("__gnat_rcheck_"))
+	    Kind = Callee->getName ().drop_front (14).str ();
+	  else if (Callee
+		   && Callee->getName () == "__gnat_last_chance_handler")
+	    Kind = "unknown";
+	  else
+	    continue;
+
+	  if (Kind.size () > 4 && StringRef (Kind).endswith ("_ext"))
+	    Kind.resize (Kind.size () - 4);
+
+	  Counts[{F.getName ().str (), Kind}]
+	    += std::max (1u, (unsigned) pred_size (I.getParent ()));
+	}
+
+  return Counts;
+}
+
+extern "C"
+void
+Record_Emitted_Checks (Module *M)
+{
+  Emitted_Checks = Count_Checks (M);
+}
+
+/* Write the number of checks of each kind emitted in each function of M,
+   the code of Unit, and the number remaining now, as JSON into FileName.
+   Functions are listed from the one with the most remaining checks.
+   Return nonzero on error.  */
+
+extern "C"
+LLVMBool
+Write_Check_Stats (Module *M, const char *Unit, const char *FileName,
+		   char **ErrorMessage)
+{
+  struct Count
+  {
+    unsigned Emitted = 0;
+    unsigned Remaining = 0;
+  };
+  std::map<std::string, std::map<std::string, Count>> Functions;
+  std::map<std::string, Count> Totals;
+  std::error_code EC;
+  raw_fd_ostream OS (FileName, EC, fs::OF_Text);
+
+  if (EC)
+    {
+      *ErrorMessage = strdup (EC.message ().c_str ());
+      return 1;
+    }
+
+  for (auto &[Key, N] : Emitted_Checks)
+    {
+      Functions[Key.first][Key.second].Emitted += N;
+      Totals[Key.second].Emitted += N;
+    }
+
+  for (auto &[Key, N] : Count_Checks (M))
+    {
+      Functions[Key.first][Key.second].Remaining += N;
+      Totals[Key.second].Remaining += N;
+    }
+
+  // A function that was inlined everywhere and deleted has no remaining
+  // checks, and one that's only been created by the optimizer has no
+  // emitted checks, so both sides may be zero.
+
+  std::vector<std::pair<const std::string *, unsigned>> Sorted;
+  for (auto &[Name, Kinds] : Functions)
+    {
+      unsigned Remaining = 0;
+
+      for (auto &K : Kinds)
+	Remaining += K.second.Remaining;
+      Sorted.push_back ({&Name, Remaining});
+    }
+
+  llvm::stable_sort (Sorted, [] (const auto &L, const auto &R) {
+    return L.second > R.second;
+  });
+
+  auto Write_Kinds = [] (json::OStream &J,
+			 const std::map<std::string, Count> &Kinds) {
+    J.attributeArray ("checks", [&] {
+      for (auto &[Kind, C] : Kinds)
+	J.object ([&] {
+	  J.attribute ("kind", Kind);
+	  J.attribute ("emitted", (int64_t) C.Emitted);
+	  J.attribute ("remaining", (int64_t) C.Remaining);
+	});
+    });
+  };
+
+  json::OStream J (OS, 2);
+  J.object ([&] {
+    J.attribute ("unit", Unit);
+    J.attributeArray ("subprograms", [&] {
+      for (auto &[Name, Remaining] : Sorted)
+	J.object ([&] {
+	  J.attribute ("name", *Name);
+	  J.attribute ("remaining", (int64_t) Remaining);
+	  Write_Kinds (J, Functions[*Name]);
+	});
+    });
+    J.attributeObject ("total", [&] { Write_Kinds (J, Totals); });
+  });
+  OS << "\n";
+
+  Emitted_Checks.clear ();
+  return 0;
+}
+
+/* Support for the compile cache.  An entry is keyed by a hash of the
+   module's bitcode before optimization, a string describing the options
+   that affect the code we generate, and the contents of the profile used
+   for optimization, if any.  Entries are kept in files whose names start
+   with "llvmcache-" so that we can bound the size of the cache with the
+   same pruning code as LLVM's ThinLTO cache.  The number of hits and
+   misses is kept in a "stats" file in the cache directory.  */
+
+static std::string
+Compile_Cache_Entry (const char *Dir, const char *Key, const char *Ext)
+{
+  SmallString<128> Path (Dir);
+
+  path::append (Path, Twine ("llvmcache-") + Key + Ext);
+  return std::string (Path.str ());
+}
+
+/* Read the hit and miss counters from the open stats file FD.  The file
+   holds a single line with both counters, which is rewritten in place on
+   each lookup, so its size stays bounded however many compilations use
+   the cache.  */
+
+static void
+Compile_Cache_Read_Counts (int FD, unsigned long long *Hits,
+			   unsigned long long *Misses)
+{
+  char Buf[64];
+  auto Read = fs::readNativeFileSlice (FD, MutableArrayRef<char> (Buf), 0);
+  StringRef Line, Rest;
+
+  *Hits = *Misses = 0;
+  if (!Read)
+    {
+      consumeError (Read.takeError ());
+      return;
+    }
+
+  std::tie (Line, Rest) = StringRef (Buf, *Read).split ('\n');
+  std::tie (Line, Rest) = Line.split (' ');
+  if (Line.getAsInteger (10, *Hits) || Rest.getAsInteger (10, *Misses))
+    *Hits = *Misses = 0;
+}
+
+static void
+Compile_Cache_Record (const char *Dir, bool Hit)
+{
+  SmallString<128> Path (Dir);
+  unsigned long long Hits, Misses;
+  int FD;
+
+  path::append (Path, "stats");
+
+  // Concurrent compilations serialize their updates by locking the file.
+  // We truncate it after the new line, which also discards a log in the
+  // format of earlier versions, which had a line per lookup.
+  if (fs::openFileForReadWrite (Path, FD, fs::CD_OpenAlways, fs::OF_None))
+    return;
+
+  if (!fs::lockFile (FD))
+    {
+      Compile_Cache_Read_Counts (FD, &Hits, &Misses);
+      (Hit ? Hits : Misses)++;
+
+      raw_fd_ostream OS (FD, false);
+      OS.seek (0);
+      OS << Hits << ' ' << Misses << '\n';
+      OS.flush ();
+      fs::resize_file (FD, OS.tell ());
+      fs::unlockFile (FD);
+    }
+
+  Process::SafelyCloseFileDescriptor (FD);
+}
+
+/* Prune the cache in Dir to at most MaxSize bytes (if nonzero).  Besides
+   the entries, which LLVM's pruning code handles, remove the temporary
+   files left behind by compilations that were killed while storing an
+   entry.  A compilation copies an entry in well under an hour, so older
+   temporary files are stale.  */
+
+static void
+Compile_Cache_Prune (const char *Dir, unsigned long long MaxSize)
+{
+  CachePruningPolicy Policy;
+  std::error_code EC;
+  auto Limit = std::chrono::system_clock::now () - std::chrono::hours (1);
+
+  Policy.MaxSizeBytes = MaxSize;
+  pruneCache (Dir, Policy);
+
+  for (fs::directory_iterator I (Dir, EC), E; I != E && !EC; I.increment (EC))
+    {
+      fs::file_status Status;
+
+      if (path::filename (I->path ()).startswith ("tmp-")
+	  && !fs::status (I->path (), Status)
+	  && Status.getLastModificationTime () < Limit)
+	fs::remove (I->path ());
+    }
+}
+
+extern "C"
+char *
+Compile_Cache_Key (Module *M, const char *Options, const char *ProfileFile)
+{
+  SmallString<0> BC;
+  raw_svector_ostream BCOS (BC);
+  BLAKE3 Hasher;
+
+  WriteBitcodeToFile (*M, BCOS);
+  Hasher.update (BC);
+  Hasher.update (StringRef (Options, strlen (Options) + 1));
+
+  if (ProfileFile != nullptr)
+    {
+      auto Buf = MemoryBuffer::getFile (ProfileFile);
+
+      if (!Buf)
+	return nullptr;
+
+      Hasher.update ((*Buf)->getBuffer ());
+    }
+
+  return strdup (toHex (Hasher.final (), true).c_str ());
+}
+
+/* If the cache in Dir has an entry for Key and Ext, copy it to Output and
+   return nonzero.  */
+
+extern "C"
+LLVMBool
+Compile_Cache_Lookup (const char *Dir, const char *Key, const char *Ext,
+		      const char *Output)
+{
+  std::string Entry = Compile_Cache_Entry (Dir, Key, Ext);
+  int FD;
+
+  if (fs::copy_file (Entry, Output))
+    {
+      Compile_Cache_Record (Dir, false);
+      return 0;
+    }
+
+  // Pruning evicts the least recently used entries, so record this use
+  // even if the file system doesn't maintain access times.
+  if (!fs::openFileForWrite (Entry, FD, fs::CD_OpenExisting, fs::OF_Append))
+    {
+      fs::setLastAccessAndModificationTime (FD, toTimePoint (time (nullptr)));
+      Process::SafelyCloseFileDescriptor (FD);
+    }
+
+  Compile_Cache_Record (Dir, true);
+  return 1;
+}
+
+/* Add Output to the cache in Dir as the entry for Key and Ext and prune the
+   cache to at most MaxSize bytes (if nonzero).  The entry is first copied
+   to a temporary file and then renamed, so that concurrent compilations
+   never see a partial entry.  Return nonzero on error.  */
+
+extern "C"
+LLVMBool
+Compile_Cache_Store (const char *Dir, const char *Key, const char *Ext,
+		     const char *Output, unsigned long long MaxSize,
+		     char **ErrorMessage)
+{
+  SmallString<128> Model (Dir), Temp;
+  std::error_code EC;
+  int FD;
+
+  path::append (Model, "tmp-%%%%%%%%%%%%");
+  if (!(EC = fs::create_directories (Dir))
+      && !(EC = fs::createUniqueFile (Model, FD, Temp)))
+    {
+      Process::SafelyCloseFileDescriptor (FD);
+      if ((EC = fs::copy_file (Output, Temp))
+	  || (EC = fs::rename (Temp, Compile_Cache_Entry (Dir, Key, Ext))))
+	fs::remove (Temp);
+    }
+
+  if (EC)
+    {
+      *ErrorMessage = strdup (EC.message ().c_str ());
+      return 1;
+    }
+
+  Compile_Cache_Prune (Dir, MaxSize);
+  return 0;
+}
+
+/* Return the number of hits and misses recorded for the cache in Dir.  */
+
+extern "C"
+void
+Compile_Cache_Stats (const char *Dir, unsigned *Hits, unsigned *Misses)
+{
+  SmallString<128> Path (Dir);
+  unsigned long long H = 0, M = 0;
+  int FD;
+
+  path::append (Path, "stats");
+  if (!fs::openFileForRead (Path, FD))
+    {
+      Compile_Cache_Read_Counts (FD, &H, &M);
+      Process::SafelyCloseFileDescriptor (FD);
+    }
+
+  *Hits = std::min<unsigned long long> (H, UINT_MAX);
+  *Misses = std::min<unsigned long long> (M, UINT_MAX);
+}
+
+extern "C"
+Value *
+Get_Float_From_Words_And_Exp (LLVMContext *Context, Type *T, int Exp,
+			      unsigned NumWords, const uint64_t Words[])
 {
   auto LongInt = APInt (NumWords * 64, {Words, NumWords});
   auto Initial = APFloat (T->getFltSemantics (),
@@ -1208,6 +2639,15 @@ Has_SEH (const char *Target)
              || TargetTriple.getArch () == Triple::aarch64);
 }
 
+extern "C"
+bool
+Has_ELF_Object_Format (const char *Target)
+{
+  Triple TargetTriple(Target);
+
+  return TargetTriple.isOSBinFormatELF ();
+}
+
 extern "C"
 const char *
 Get_Personality_Function_Name (const char *Target)
@@ -1330,3 +2770,144 @@ Print_Targets (void)
 {
   TargetRegistry::printRegisteredTargetsForVersion(outs());
 }
+
+/* The results of proving the unit being compiled with gnatprove, read from
+   the .spark file that gnat2why writes for it.  For each check, identified
+   by the location and kind that gnat2why reports, we record whether it was
+   proved, which it is only if every message about it says so.  We also
+   record the SHA-1 digest of the contents of each source file that was
+   analyzed, so our caller can tell whether the results are stale.  */
+
+struct Proof_Results
+{
+  StringMap<bool> Checks;
+  StringMap<std::string> Sources;
+};
+
+static Proof_Results *The_Proof_Results = nullptr;
+
+static std::string
+Proof_Check_Key (StringRef File, int64_t Line, int64_t Col, StringRef Rule)
+{
+  return (File + ":" + Twine (Line) + ":" + Twine (Col) + ":" + Rule).str ();
+}
+
+/* Read the proof results in FileName.  Return nonzero on error.  */
+
+extern "C"
+LLVMBool
+Read_Proof_Results (const char *FileName, char **ErrorMessage)
+{
+  auto Buffer = MemoryBuffer::getFile (FileName, true);
+
+  if (!Buffer)
+    {
+      *ErrorMessage = strdup (Buffer.getError ().message ().c_str ());
+      return 1;
+    }
+
+  Expected<json::Value> Root = json::parse ((*Buffer)->getBuffer ());
+
+  if (!Root)
+    {
+      *ErrorMessage = strdup (toString (Root.takeError ()).c_str ());
+      return 1;
+    }
+
+  const json::Object *Obj = Root->getAsObject ();
+
+  if (!Obj)
+    {
+      *ErrorMessage = strdup ("not a JSON object");
+      return 1;
+    }
+
+  auto R = std::make_unique<Proof_Results> ();
+
+  if (const json::Array *Sources = Obj->getArray ("sources"))
+    for (const json::Value &V : *Sources)
+      if (const json::Object *Source = V.getAsObject ())
+	{
+	  auto File = Source->getString ("file");
+	  auto Digest = Source->getString ("sha1");
+
+	  if (File && Digest)
+	    R->Sources[*File] = Digest->str ();
+	}
+
+  // A check is located at its VC location when there is one, which is
+  // the location of the node the front end put the check on.
+
+  if (const json::Array *Proof = Obj->getArray ("proof"))
+    for (const json::Value &V : *Proof)
+      if (const json::Object *Msg = V.getAsObject ())
+	{
+	  bool Has_VC_Loc = Msg->getString ("check_file").has_value ();
+	  auto File = Msg->getString (Has_VC_Loc ? "check_file" : "file");
+	  auto Line = Msg->getInteger (Has_VC_Loc ? "check_line" : "line");
+	  auto Col = Msg->getInteger (Has_VC_Loc ? "check_col" : "col");
+	  auto Rule = Msg->getString ("rule");
+	  auto Severity = Msg->getString ("severity");
+
+	  if (!File || !Line || !Col || !Rule || !Severity)
+	    continue;
+
+	  bool Proved = *Severity == "info" && !Msg->get ("suppressed");
+	  auto Entry
+	    = R->Checks.try_emplace (Proof_Check_Key (*File, *Line, *Col,
+						      *Rule),
+				     Proved);
+
+	  if (!Entry.second)
+	    Entry.first->second &= Proved;
+	}
+
+  delete The_Proof_Results;
+  The_Proof_Results = R.release ();
+  return 0;
+}
+
+/* Return the SHA-1 digest, in hexadecimal, of the source file File that
+   was analyzed by gnatprove, or nullptr if it wasn't.  */
+
+extern "C"
+const char *
+Get_Proof_Source_Digest (const char *File)
+{
+  if (!The_Proof_Results)
+    return nullptr;
+
+  auto Found = The_Proof_Results->Sources.find (File);
+
+  if (Found == The_Proof_Results->Sources.end ())
+    return nullptr;
+
+  return Found->second.c_str ();
+}
+
+/* Return nonzero if the check of kind Rule at Line and Col of File was
+   proved.  */
+
+extern "C"
+LLVMBool
+Is_Check_Proved (const char *File, unsigned Line, unsigned Col,
+		 const char *Rule)
+{
+  if (!The_Proof_Results)
+    return 0;
+
+  auto Found
+    = The_Proof_Results->Checks.find (Proof_Check_Key (File, Line, Col, Rule));
+
+  return Found != The_Proof_Results->Checks.end () && Found->second;
+}
+
+/* Forget the proof results, for example because they're stale.  */
+
+extern "C"
+void
+Discard_Proof_Results (void)
+{
+  delete The_Proof_Results;
+  The_Proof_Results = nullptr;
+}
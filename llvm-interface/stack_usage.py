@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""Estimate the worst-case stack usage of each task of a program.
+
+This combines the .su and .ci files that llvm-gcc writes for each unit
+compiled with -fstack-usage.  A .su file gives the frame size of each
+subprogram of the unit and a .ci file the subprograms that each one calls.
+The stack usage of a subprogram is its frame size plus the largest stack
+usage of the subprograms it calls, so the estimate for a task is that of
+its body.
+
+The estimate is only an upper bound when the whole call graph is known,
+so we report which subprograms have frames of dynamic size, make
+indirect calls, call subprograms for which we have no .su file (for
+example those of a runtime that wasn't compiled with -fstack-usage) or
+are recursive.
+
+By default, the roots for which we report the stack usage are the task
+bodies and the main program, but they can be given with --root.
+"""
+
+import argparse
+import os
+import sys
+
+
+class Node:
+    def __init__(self, name):
+        self.name = name
+        self.label = name
+        self.size = None
+        self.dynamic = False
+        self.callees = set()
+        self.indirect = False
+
+
+def read_files(paths):
+    """Read the .su and .ci files in PATHS, which may be directories."""
+    files = []
+    for path in paths:
+        if os.path.isdir(path):
+            for entry in sorted(os.listdir(path)):
+                if entry.endswith((".su", ".ci")):
+                    files.append(os.path.join(path, entry))
+        else:
+            files.append(path)
+
+    nodes = {}
+    sizes = {}
+
+    def node(name):
+        return nodes.setdefault(name, Node(name))
+
+    for f in files:
+        with open(f) as fd:
+            for line in fd:
+                fields = line.rstrip("\n").split("\t")
+                if f.endswith(".su") and len(fields) == 3:
+                    sizes[fields[0]] = (int(fields[1]),
+                                        fields[2].startswith("dynamic"))
+                elif fields[0] == "node" and len(fields) == 3:
+                    node(fields[1]).label = fields[2]
+                elif fields[0] == "call" and len(fields) == 3:
+                    node(fields[1]).callees.add(node(fields[2]))
+                elif fields[0] == "indirect" and len(fields) == 2:
+                    node(fields[1]).indirect = True
+
+    for n in nodes.values():
+        if n.label in sizes:
+            n.size, n.dynamic = sizes[n.label]
+
+    return nodes
+
+
+def ada_name(n):
+    return n.label.rsplit(":", 1)[-1]
+
+
+class Estimate:
+    def __init__(self):
+        self.usage = 0
+        self.path = []
+        self.dynamic = set()
+        self.indirect = set()
+        self.unknown = set()
+        self.recursive = set()
+
+
+def estimate(n, memo, active):
+    """Return the Estimate of the stack usage of N."""
+    if n in memo:
+        return memo[n]
+
+    e = Estimate()
+    if n in active:
+        e.recursive.add(n)
+        return e
+
+    active.add(n)
+    worst = None
+    for c in sorted(n.callees, key=lambda c: c.name):
+        ce = estimate(c, memo, active)
+        if worst is None or ce.usage > worst.usage:
+            worst = ce
+        e.dynamic |= ce.dynamic
+        e.indirect |= ce.indirect
+        e.unknown |= ce.unknown
+        e.recursive |= ce.recursive
+    active.remove(n)
+
+    if n.size is None:
+        e.unknown.add(n)
+    if n.dynamic:
+        e.dynamic.add(n)
+    if n.indirect:
+        e.indirect.add(n)
+
+    e.usage = (n.size or 0) + (worst.usage if worst else 0)
+    e.path = [n] + (worst.path if worst else [])
+
+    # An estimate computed while one of our callers was active may have been
+    # cut short by recursion, so only remember complete ones.
+    if not e.recursive:
+        memo[n] = e
+    return e
+
+
+def is_default_root(n):
+    return (n.name.endswith("TKB") or n.name == "main"
+            or n.name.startswith("_ada_"))
+
+
+def names(nodes):
+    return ", ".join(sorted(ada_name(n) for n in nodes))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Estimate the worst-case stack usage of each task.")
+    parser.add_argument("files", nargs="+",
+                        help=".su and .ci files, or directories with them")
+    parser.add_argument("--root", action="append", default=[],
+                        help="linker or Ada name of a subprogram to report"
+                             " on (default: task bodies and main program)")
+    parser.add_argument("--path", action="store_true",
+                        help="show the call chain using the most stack")
+    args = parser.parse_args()
+
+    nodes = read_files(args.files)
+    if args.root:
+        roots = [n for n in nodes.values()
+                 if n.name in args.root or ada_name(n) in args.root]
+    else:
+        roots = [n for n in nodes.values() if is_default_root(n)]
+
+    if not roots:
+        print("no subprograms to report on", file=sys.stderr)
+        return 1
+
+    memo = {}
+    for root in sorted(roots, key=ada_name):
+        e = estimate(root, memo, set())
+        print("%s: %d bytes" % (ada_name(root), e.usage))
+        if e.dynamic:
+            print("  dynamic frames: " + names(e.dynamic))
+        if e.indirect:
+            print("  indirect calls: " + names(e.indirect))
+        if e.unknown:
+            print("  no stack usage: " + names(e.unknown))
+        if e.recursive:
+            print("  recursion through: " + names(e.recursive))
+        if args.path:
+            for n in e.path:
+                print("    %-8s %s" % (n.size if n.size is not None else "?",
+                                       n.label))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
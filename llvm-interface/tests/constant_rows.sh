@@ -0,0 +1,46 @@
+#!/bin/sh
+# Test that the static rows of an array aggregate that isn't static as a
+# whole are copied from constant globals.  Rows has a 256 by 256 table
+# whose first row depends on a parameter and whose other rows are
+# distinct static aggregates.  We expect each of those rows to be copied
+# by a memcpy from a constant global, so that the IR has far fewer stores
+# than the 65_536 components of the table.  Prints PASSED if so.
+#
+# Usage: constant_rows.sh LLVM-GCC, run in an empty directory.
+
+GCC=$1
+N=256
+
+{
+  echo "function Rows (V, I, J : Integer) return Integer is"
+  echo "   type Table is array (1 .. $N, 1 .. $N) of Integer;"
+  echo "   T : constant Table :="
+  printf '     (1 => ('
+  yes V | head -n $N | paste -sd, - | tr -d '\n'
+  echo "),"
+  for row in $(seq 2 $N); do
+    printf '      %d => (' $row
+    seq $(( (row - 1) * N + 1 )) $(( row * N )) | paste -sd, - | tr -d '\n'
+    [ $row -lt $N ] && echo ")," || echo "));"
+  done
+  echo "begin"
+  echo "   return T (I, J);"
+  echo "end Rows;"
+} > rows.adb
+
+"$GCC" -c -S -emit-llvm -O0 rows.adb > compile.log 2>&1 \
+  || { echo "FAILED: compilation"; exit 1; }
+
+globals=$(grep -c "= private unnamed_addr constant \[$N x i32\]" rows.ll)
+copies=$(grep -c "call void @llvm.memcpy" rows.ll)
+stores=$(grep -c "store i32" rows.ll)
+
+if [ "$globals" -lt $((N - 1)) ]; then
+  echo "FAILED: $globals constant rows instead of $((N - 1))"
+elif [ "$copies" -lt $((N - 1)) ]; then
+  echo "FAILED: $copies copies for $((N - 1)) constant rows"
+elif [ "$stores" -ge $((4 * N)) ]; then
+  echo "FAILED: $stores stores of components"
+else
+  echo PASSED
+fi
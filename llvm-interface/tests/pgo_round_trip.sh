@@ -0,0 +1,85 @@
+#!/bin/sh
+# Test a round trip through profile-guided optimization.  We build
+# Pgo_Main with -fprofile-generate, check that it's instrumented, run it
+# and merge the raw profile it writes with llvm-profdata.  We then compile
+# it with -fprofile-use and expect the profile to be found to match the
+# code and its branches to get weights from it, and build and run it once
+# more.  Prints PASSED if so.
+#
+# Usage: pgo_round_trip.sh LLVM-GCC [LLVM-GNATMAKE], run in an empty
+# directory.  LLVM_PROFDATA names llvm-profdata if it's not on the PATH.
+
+GCC=$1
+GNATMAKE=${2:-$(dirname "$GCC")/llvm-gnatmake}
+PROFDATA=${LLVM_PROFDATA:-llvm-profdata}
+
+command -v "$PROFDATA" > /dev/null \
+  || { echo "FAILED: $PROFDATA not found"; exit 1; }
+
+cat > pgo_main.adb <<'ADA'
+with Ada.Text_IO; use Ada.Text_IO;
+
+procedure Pgo_Main is
+   function Rare (I : Positive) return Boolean
+     with No_Inline;
+
+   function Rare (I : Positive) return Boolean is (I mod 97 = 0);
+
+   Count : Natural := 0;
+
+begin
+   for I in 1 .. 1_000_000 loop
+      if Rare (I) then
+         Count := Count + 1;
+      end if;
+   end loop;
+
+   if Count = 10_309 then
+      Put_Line ("PASSED");
+   else
+      Put_Line ("FAILED: " & Count'Image);
+   end if;
+end Pgo_Main;
+ADA
+
+# Build Pgo_Main in directory $1 with the switches in the rest of the
+# arguments, given both to the compiler and to the linker, and run it.
+
+build_and_run ()
+{
+  dir=$1
+  shift
+  mkdir -p $dir
+  (cd $dir \
+   && "$GNATMAKE" -q -O2 ../pgo_main.adb -cargs "$@" -largs "$@" \
+        > build.log 2>&1 \
+   && ./pgo_main > run.log 2>&1 && grep -qx PASSED run.log) \
+    || { echo "FAILED: $dir build, see $dir/*.log"; exit 1; }
+}
+
+build_and_run gen -fprofile-generate="$(pwd)/prof"
+grep -q __profc_ gen/pgo_main.o \
+  || { echo "FAILED: not instrumented"; exit 1; }
+ls prof/*.profraw > /dev/null 2>&1 \
+  || { echo "FAILED: no raw profile"; exit 1; }
+
+"$PROFDATA" merge -o pgo.profdata prof/*.profraw > merge.log 2>&1 \
+  || { echo "FAILED: merge"; exit 1; }
+
+"$GCC" -c -S -emit-llvm -O2 -fprofile-use=pgo.profdata pgo_main.adb \
+  > compile.log 2>&1 || { echo "FAILED: compilation"; exit 1; }
+
+if grep -qi "profile" compile.log; then
+  echo "FAILED: profile not used:"
+  cat compile.log
+  exit 1
+elif ! grep -q "function_entry_count" pgo_main.ll; then
+  echo "FAILED: no entry counts from the profile"
+  exit 1
+elif ! grep -q "branch_weights" pgo_main.ll; then
+  echo "FAILED: no branch weights from the profile"
+  exit 1
+fi
+
+build_and_run use -fprofile-use="$(pwd)/pgo.profdata"
+echo PASSED
@@ -0,0 +1,78 @@
+#!/bin/sh
+# Test that -fproof-results only uses results whose sources are exactly
+# ours.  Sum has two index checks, on consecutive lines, and the results
+# we write for it say that the second one was proved.  With them, one of
+# the checks is omitted.  We then insert a blank line before the first
+# check, which doesn't change the GNAT checksum of the file but moves
+# that check to the line of the proved one, and expect the results to be
+# found out of date and both checks to be kept.  Prints PASSED if so.
+#
+# Usage: proof_results.sh LLVM-GCC, run in an empty directory.
+
+GCC=$1
+
+write_source ()
+{
+  cat > sum.adb <<EOF
+function Sum (A : String; I, J : Positive) return Natural is
+$1begin
+   return Character'Pos (A (I))
+     + Character'Pos (A (J));
+end Sum;
+EOF
+}
+
+# Write results for sum.adb that say that each index check at line $1 was
+# proved.  We don't know the column gnat2why would give, so we say so for
+# every column.
+
+write_results ()
+{
+  sha1=$(sha1sum sum.adb | cut -d' ' -f1)
+  {
+    printf '{"sources": [{"file": "sum.adb", "sha1": "%s"}], "proof": [' \
+      "$sha1"
+    sep=
+    for col in $(seq 1 40); do
+      printf '%s{"file": "sum.adb", "line": %d, "col": %d,' "$sep" $1 $col
+      printf ' "rule": "VC_INDEX_CHECK", "severity": "info"}'
+      sep=", "
+    done
+    printf ']}\n'
+  } > results/sum.spark
+}
+
+# Compile sum.adb with the switches in $@ and print the number of index
+# checks left in the generated IR.
+
+index_checks ()
+{
+  "$GCC" -c -S -emit-llvm -O0 "$@" sum.adb > compile.log 2>&1 || exit 1
+  grep -c 'call.*__gnat_rcheck_CE_Index_Check' sum.ll || :
+}
+
+mkdir -p results
+write_source ""
+all=$(index_checks) || { echo "FAILED: compilation"; exit 1; }
+
+write_results 4
+fresh=$(index_checks -fproof-results=results) \
+  || { echo "FAILED: compilation with fresh results"; exit 1; }
+if [ "$fresh" -ge "$all" ]; then
+  echo "FAILED: $fresh of $all index checks kept with fresh results"
+  exit 1
+fi
+
+write_source "
+"
+stale=$(index_checks -fproof-results=results) \
+  || { echo "FAILED: compilation with stale results"; exit 1; }
+if [ "$stale" -ne "$all" ]; then
+  echo "FAILED: $stale of $all index checks kept with stale results"
+  exit 1
+elif ! grep -q "out of date" compile.log; then
+  echo "FAILED: no warning about stale results"
+  exit 1
+fi
+
+echo PASSED
@@ -0,0 +1,143 @@
+------------------------------------------------------------------------------
+--                             G N A T - L L V M                            --
+--                                                                          --
+--                       Copyright (C) 2023, AdaCore                        --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.  You should have  received  a copy of the GNU --
+-- General  Public  License  distributed  with  this  software;   see  file --
+-- COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy --
+-- of the license.                                                          --
+------------------------------------------------------------------------------
+
+--  Test the comparison __builtin_vector operations, which return a mask
+--  with all ones in the lanes where the comparison holds, on signed,
+--  unsigned and floating-point lanes, and the selection by such a mask.
+
+with Ada.Text_IO; use Ada.Text_IO;
+with Interfaces;  use Interfaces;
+
+procedure Vector_Compare is
+
+   type Int_Vector is array (0 .. 3) of Integer_32;
+   pragma Machine_Attribute (Int_Vector, "vector_type");
+
+   type Uns_Vector is array (0 .. 3) of Unsigned_32;
+   pragma Machine_Attribute (Uns_Vector, "vector_type");
+
+   type Flt_Vector is array (0 .. 3) of IEEE_Float_32;
+   pragma Machine_Attribute (Flt_Vector, "vector_type");
+
+   type Mask_Vector is array (0 .. 3) of Integer_32;
+   pragma Machine_Attribute (Mask_Vector, "vector_type");
+
+   function Eq (A, B : Int_Vector) return Mask_Vector;
+   function Ne (A, B : Int_Vector) return Mask_Vector;
+   function Lt (A, B : Int_Vector) return Mask_Vector;
+   function Le (A, B : Int_Vector) return Mask_Vector;
+   function Gt (A, B : Int_Vector) return Mask_Vector;
+   function Ge (A, B : Int_Vector) return Mask_Vector;
+   pragma Import (Intrinsic, Eq, "__builtin_vector_eq");
+   pragma Import (Intrinsic, Ne, "__builtin_vector_ne");
+   pragma Import (Intrinsic, Lt, "__builtin_vector_lt");
+   pragma Import (Intrinsic, Le, "__builtin_vector_le");
+   pragma Import (Intrinsic, Gt, "__builtin_vector_gt");
+   pragma Import (Intrinsic, Ge, "__builtin_vector_ge");
+
+   function Lt (A, B : Uns_Vector) return Mask_Vector;
+   function Ge (A, B : Uns_Vector) return Mask_Vector;
+   pragma Import (Intrinsic, Lt, "__builtin_vector_lt");
+   pragma Import (Intrinsic, Ge, "__builtin_vector_ge");
+
+   function Eq (A, B : Flt_Vector) return Mask_Vector;
+   function Ne (A, B : Flt_Vector) return Mask_Vector;
+   function Lt (A, B : Flt_Vector) return Mask_Vector;
+   function Ge (A, B : Flt_Vector) return Mask_Vector;
+   pragma Import (Intrinsic, Eq, "__builtin_vector_eq");
+   pragma Import (Intrinsic, Ne, "__builtin_vector_ne");
+   pragma Import (Intrinsic, Lt, "__builtin_vector_lt");
+   pragma Import (Intrinsic, Ge, "__builtin_vector_ge");
+
+   function Select_V (M : Mask_Vector; A, B : Int_Vector) return Int_Vector;
+   pragma Import (Intrinsic, Select_V, "__builtin_vector_select");
+
+   function Opaque (V : Int_Vector) return Int_Vector;
+   function Opaque (V : Uns_Vector) return Uns_Vector;
+   function Opaque (V : Flt_Vector) return Flt_Vector;
+   pragma No_Inline (Opaque);
+   --  Return V, hiding its value from the optimizer
+
+   procedure Check (Name : String; Got, Want : Mask_Vector);
+   --  Report whether Got is Want
+
+   Failed : Boolean := False;
+
+   ------------
+   -- Opaque --
+   ------------
+
+   function Opaque (V : Int_Vector) return Int_Vector is (V);
+   function Opaque (V : Uns_Vector) return Uns_Vector is (V);
+   function Opaque (V : Flt_Vector) return Flt_Vector is (V);
+
+   -----------
+   -- Check --
+   -----------
+
+   procedure Check (Name : String; Got, Want : Mask_Vector) is
+   begin
+      if Got /= Want then
+         Put_Line ("FAILED: " & Name);
+         Failed := True;
+      end if;
+   end Check;
+
+   IA : constant Int_Vector := Opaque ([-5, 0, 7, 3]);
+   IB : constant Int_Vector := Opaque ([-5, 1, -7, 4]);
+
+   --  The unsigned lanes differ from the signed ones in their ordering:
+   --  2**31 is larger than 1 as an unsigned value, but not as a signed one.
+
+   UA : constant Uns_Vector := Opaque ([2**31, 1, 5, 0]);
+   UB : constant Uns_Vector := Opaque ([1, 2**31, 5, 0]);
+
+   --  NaN is unordered, so only "ne" holds when comparing it
+
+   FZ  : constant Flt_Vector    := Opaque ([0.0, 0.0, 0.0, 0.0]);
+   NaN : constant IEEE_Float_32 := FZ (0) / FZ (1);
+   FA  : constant Flt_Vector    := Opaque ([1.0, NaN, -0.0, 2.5]);
+   FB  : constant Flt_Vector    := Opaque ([2.0, NaN, 0.0, 2.5]);
+
+   T : constant Integer_32 := -1;
+   F : constant Integer_32 := 0;
+
+begin
+   Check ("signed eq", Eq (IA, IB), [T, F, F, F]);
+   Check ("signed ne", Ne (IA, IB), [F, T, T, T]);
+   Check ("signed lt", Lt (IA, IB), [F, T, F, T]);
+   Check ("signed le", Le (IA, IB), [T, T, F, T]);
+   Check ("signed gt", Gt (IA, IB), [F, F, T, F]);
+   Check ("signed ge", Ge (IA, IB), [T, F, T, F]);
+
+   Check ("unsigned lt", Lt (UA, UB), [F, T, F, F]);
+   Check ("unsigned ge", Ge (UA, UB), [T, F, T, T]);
+
+   Check ("float eq", Eq (FA, FB), [F, F, T, T]);
+   Check ("float ne", Ne (FA, FB), [T, T, F, F]);
+   Check ("float lt", Lt (FA, FB), [T, F, F, F]);
+   Check ("float ge", Ge (FA, FB), [F, F, T, T]);
+
+   if Select_V (Lt (IA, IB), IA, IB) /= [-5, 0, -7, 3] then
+      Put_Line ("FAILED: select");
+      Failed := True;
+   end if;
+
+   if not Failed then
+      Put_Line ("PASSED");
+   end if;
+end Vector_Compare;
@@ -0,0 +1,238 @@
+------------------------------------------------------------------------------
+--                             G N A T - L L V M                            --
+--                                                                          --
+--                       Copyright (C) 2023, AdaCore                        --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.  You should have  received  a copy of the GNU --
+-- General  Public  License  distributed  with  this  software;   see  file --
+-- COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy --
+-- of the license.                                                          --
+------------------------------------------------------------------------------
+
+--  Test the lane-wise __builtin_vector operations on signed, unsigned and
+--  floating-point lanes, with operands only known at run time, against
+--  the same operations done one lane at a time.
+
+with Ada.Text_IO; use Ada.Text_IO;
+with Ada.Unchecked_Conversion;
+with Interfaces;  use Interfaces;
+
+procedure Vector_Lanewise is
+
+   type Int_Vector is array (0 .. 3) of Integer_32;
+   pragma Machine_Attribute (Int_Vector, "vector_type");
+
+   type Uns_Vector is array (0 .. 7) of Unsigned_16;
+   pragma Machine_Attribute (Uns_Vector, "vector_type");
+
+   type Flt_Vector is array (0 .. 1) of IEEE_Float_64;
+   pragma Machine_Attribute (Flt_Vector, "vector_type");
+
+   function Add (A, B : Int_Vector) return Int_Vector;
+   function Sub (A, B : Int_Vector) return Int_Vector;
+   function Mul (A, B : Int_Vector) return Int_Vector;
+   function Div (A, B : Int_Vector) return Int_Vector;
+   function Rem_V (A, B : Int_Vector) return Int_Vector;
+   function And_V (A, B : Int_Vector) return Int_Vector;
+   function Or_V (A, B : Int_Vector) return Int_Vector;
+   function Xor_V (A, B : Int_Vector) return Int_Vector;
+   function Shr (A, B : Int_Vector) return Int_Vector;
+   function Min (A, B : Int_Vector) return Int_Vector;
+   function Max (A, B : Int_Vector) return Int_Vector;
+   function Neg (A : Int_Vector) return Int_Vector;
+   function Abs_V (A : Int_Vector) return Int_Vector;
+   function Not_V (A : Int_Vector) return Int_Vector;
+   pragma Import (Intrinsic, Add, "__builtin_vector_add");
+   pragma Import (Intrinsic, Sub, "__builtin_vector_sub");
+   pragma Import (Intrinsic, Mul, "__builtin_vector_mul");
+   pragma Import (Intrinsic, Div, "__builtin_vector_div");
+   pragma Import (Intrinsic, Rem_V, "__builtin_vector_rem");
+   pragma Import (Intrinsic, And_V, "__builtin_vector_and");
+   pragma Import (Intrinsic, Or_V, "__builtin_vector_or");
+   pragma Import (Intrinsic, Xor_V, "__builtin_vector_xor");
+   pragma Import (Intrinsic, Shr, "__builtin_vector_shr");
+   pragma Import (Intrinsic, Min, "__builtin_vector_min");
+   pragma Import (Intrinsic, Max, "__builtin_vector_max");
+   pragma Import (Intrinsic, Neg, "__builtin_vector_neg");
+   pragma Import (Intrinsic, Abs_V, "__builtin_vector_abs");
+   pragma Import (Intrinsic, Not_V, "__builtin_vector_not");
+
+   function Div (A, B : Uns_Vector) return Uns_Vector;
+   function Shl (A, B : Uns_Vector) return Uns_Vector;
+   function Shr (A, B : Uns_Vector) return Uns_Vector;
+   function Min (A, B : Uns_Vector) return Uns_Vector;
+   function Max (A, B : Uns_Vector) return Uns_Vector;
+   pragma Import (Intrinsic, Div, "__builtin_vector_div");
+   pragma Import (Intrinsic, Shl, "__builtin_vector_shl");
+   pragma Import (Intrinsic, Shr, "__builtin_vector_shr");
+   pragma Import (Intrinsic, Min, "__builtin_vector_min");
+   pragma Import (Intrinsic, Max, "__builtin_vector_max");
+
+   function Add (A, B : Flt_Vector) return Flt_Vector;
+   function Mul (A, B : Flt_Vector) return Flt_Vector;
+   function Div (A, B : Flt_Vector) return Flt_Vector;
+   function Neg (A : Flt_Vector) return Flt_Vector;
+   function Abs_V (A : Flt_Vector) return Flt_Vector;
+   pragma Import (Intrinsic, Add, "__builtin_vector_add");
+   pragma Import (Intrinsic, Mul, "__builtin_vector_mul");
+   pragma Import (Intrinsic, Div, "__builtin_vector_div");
+   pragma Import (Intrinsic, Neg, "__builtin_vector_neg");
+   pragma Import (Intrinsic, Abs_V, "__builtin_vector_abs");
+
+   generic
+      type Lane is private;
+      type Vector is array (Integer range <>) of Lane;
+      with function Op (L, R : Lane) return Lane;
+   function Lanes (A, B : Vector) return Vector;
+   --  Apply Op to each pair of lanes of A and B
+
+   function Opaque (V : Int_Vector) return Int_Vector;
+   function Opaque (V : Uns_Vector) return Uns_Vector;
+   function Opaque (V : Flt_Vector) return Flt_Vector;
+   pragma No_Inline (Opaque);
+   --  Return V, hiding its value from the optimizer
+
+   procedure Check (Name : String; OK : Boolean);
+   --  Report a failure of the test Name unless OK
+
+   Failed : Boolean := False;
+
+   -----------
+   -- Lanes --
+   -----------
+
+   function Lanes (A, B : Vector) return Vector is
+      Result : Vector (A'Range);
+
+   begin
+      for J in A'Range loop
+         Result (J) := Op (A (J), B (J));
+      end loop;
+
+      return Result;
+   end Lanes;
+
+   ------------
+   -- Opaque --
+   ------------
+
+   function Opaque (V : Int_Vector) return Int_Vector is (V);
+   function Opaque (V : Uns_Vector) return Uns_Vector is (V);
+   function Opaque (V : Flt_Vector) return Flt_Vector is (V);
+
+   -----------
+   -- Check --
+   -----------
+
+   procedure Check (Name : String; OK : Boolean) is
+   begin
+      if not OK then
+         Put_Line ("FAILED: " & Name);
+         Failed := True;
+      end if;
+   end Check;
+
+   type Int_Array is array (Integer range <>) of Integer_32;
+   type Uns_Array is array (Integer range <>) of Unsigned_16;
+   type Flt_Array is array (Integer range <>) of IEEE_Float_64;
+
+   function To_U is new Ada.Unchecked_Conversion (Integer_32, Unsigned_32);
+   function To_S is new Ada.Unchecked_Conversion (Unsigned_32, Integer_32);
+
+   function And_S (L, R : Integer_32) return Integer_32 is
+     (To_S (To_U (L) and To_U (R)));
+   function Or_S (L, R : Integer_32) return Integer_32 is
+     (To_S (To_U (L) or To_U (R)));
+   function Xor_S (L, R : Integer_32) return Integer_32 is
+     (To_S (To_U (L) xor To_U (R)));
+   --  The bitwise operations on signed lanes
+
+   function Shr_S (L, R : Integer_32) return Integer_32 is
+     (To_S (Shift_Right_Arithmetic (To_U (L), Natural (R))));
+   function Shl_U (L, R : Unsigned_16) return Unsigned_16 is
+     (Shift_Left (L, Natural (R)));
+   function Shr_U (L, R : Unsigned_16) return Unsigned_16 is
+     (Shift_Right (L, Natural (R)));
+   --  The shifts of a lane, which are arithmetic for signed lanes
+
+   function I_Add is new Lanes (Integer_32, Int_Array, "+");
+   function I_Sub is new Lanes (Integer_32, Int_Array, "-");
+   function I_Mul is new Lanes (Integer_32, Int_Array, "*");
+   function I_Div is new Lanes (Integer_32, Int_Array, "/");
+   function I_Rem is new Lanes (Integer_32, Int_Array, "rem");
+   function I_And is new Lanes (Integer_32, Int_Array, And_S);
+   function I_Or  is new Lanes (Integer_32, Int_Array, Or_S);
+   function I_Xor is new Lanes (Integer_32, Int_Array, Xor_S);
+   function I_Shr is new Lanes (Integer_32, Int_Array, Shr_S);
+   function I_Min is new Lanes (Integer_32, Int_Array, Integer_32'Min);
+   function I_Max is new Lanes (Integer_32, Int_Array, Integer_32'Max);
+   function U_Div is new Lanes (Unsigned_16, Uns_Array, "/");
+   function U_Shl is new Lanes (Unsigned_16, Uns_Array, Shl_U);
+   function U_Shr is new Lanes (Unsigned_16, Uns_Array, Shr_U);
+   function U_Min is new Lanes (Unsigned_16, Uns_Array, Unsigned_16'Min);
+   function U_Max is new Lanes (Unsigned_16, Uns_Array, Unsigned_16'Max);
+   function F_Add is new Lanes (IEEE_Float_64, Flt_Array, "+");
+   function F_Mul is new Lanes (IEEE_Float_64, Flt_Array, "*");
+   function F_Div is new Lanes (IEEE_Float_64, Flt_Array, "/");
+
+   function "=" (L : Int_Vector; R : Int_Array) return Boolean is
+     (Int_Array (L) = R);
+   function "=" (L : Uns_Vector; R : Uns_Array) return Boolean is
+     (Uns_Array (L) = R);
+   function "=" (L : Flt_Vector; R : Flt_Array) return Boolean is
+     (Flt_Array (L) = R);
+
+   IA : constant Int_Vector := Opaque ([100, -7, 2_000_000, -45]);
+   IB : constant Int_Vector := Opaque ([7, 3, -3, -2]);
+   UA : constant Uns_Vector :=
+     Opaque ([1, 2, 300, 40_000, 65_535, 7, 0, 1_234]);
+   UB : constant Uns_Vector := Opaque ([1, 15, 2, 3, 4, 2, 9, 5]);
+   FA : constant Flt_Vector := Opaque ([1.5, -2.25]);
+   FB : constant Flt_Vector := Opaque ([0.5, 4.0]);
+
+begin
+   Check ("signed add", Add (IA, IB) = I_Add (Int_Array (IA), Int_Array (IB)));
+   Check ("signed sub", Sub (IA, IB) = I_Sub (Int_Array (IA), Int_Array (IB)));
+   Check ("signed mul", Mul (IA, IB) = I_Mul (Int_Array (IA), Int_Array (IB)));
+   Check ("signed div", Div (IA, IB) = I_Div (Int_Array (IA), Int_Array (IB)));
+   Check ("signed rem",
+          Rem_V (IA, IB) = I_Rem (Int_Array (IA), Int_Array (IB)));
+   Check ("signed shr",
+          Shr (IA, Opaque ([1, 2, 3, 4])) =
+            I_Shr (Int_Array (IA), [1, 2, 3, 4]));
+   Check ("signed min", Min (IA, IB) = I_Min (Int_Array (IA), Int_Array (IB)));
+   Check ("signed max", Max (IA, IB) = I_Max (Int_Array (IA), Int_Array (IB)));
+   Check ("and", And_V (IA, IB) = I_And (Int_Array (IA), Int_Array (IB)));
+   Check ("or", Or_V (IA, IB) = I_Or (Int_Array (IA), Int_Array (IB)));
+   Check ("xor", Xor_V (IA, IB) = I_Xor (Int_Array (IA), Int_Array (IB)));
+   Check ("neg", Neg (IA) = Int_Vector'[for X of IA => -X]);
+   Check ("abs", Abs_V (IA) = Int_Vector'[for X of IA => abs X]);
+   Check ("not", Not_V (IA) = Int_Vector'[for X of IA => -X - 1]);
+
+   Check ("unsigned div",
+          Div (UA, UB) = U_Div (Uns_Array (UA), Uns_Array (UB)));
+   Check ("unsigned shl",
+          Shl (UA, UB) = U_Shl (Uns_Array (UA), Uns_Array (UB)));
+   Check ("unsigned shr",
+          Shr (UA, UB) = U_Shr (Uns_Array (UA), Uns_Array (UB)));
+   Check ("unsigned min",
+          Min (UA, UB) = U_Min (Uns_Array (UA), Uns_Array (UB)));
+   Check ("unsigned max",
+          Max (UA, UB) = U_Max (Uns_Array (UA), Uns_Array (UB)));
+
+   Check ("float add", Add (FA, FB) = F_Add (Flt_Array (FA), Flt_Array (FB)));
+   Check ("float mul", Mul (FA, FB) = F_Mul (Flt_Array (FA), Flt_Array (FB)));
+   Check ("float div", Div (FA, FB) = F_Div (Flt_Array (FA), Flt_Array (FB)));
+   Check ("float neg", Neg (FA) = Flt_Vector'[-1.5, 2.25]);
+   Check ("float abs", Abs_V (FA) = Flt_Vector'[1.5, 2.25]);
+
+   if not Failed then
+      Put_Line ("PASSED");
+   end if;
+end Vector_Lanewise;
@@ -0,0 +1,95 @@
+------------------------------------------------------------------------------
+--                             G N A T - L L V M                            --
+--                                                                          --
+--                       Copyright (C) 2023, AdaCore                        --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.  You should have  received  a copy of the GNU --
+-- General  Public  License  distributed  with  this  software;   see  file --
+-- COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy --
+-- of the license.                                                          --
+------------------------------------------------------------------------------
+
+--  Test __builtin_vector_masked_load and __builtin_vector_masked_store,
+--  which only access the lanes of memory whose mask is nonzero, with masks
+--  only known at run time.
+
+with Ada.Text_IO; use Ada.Text_IO;
+with Interfaces;  use Interfaces;
+with System;      use System;
+
+procedure Vector_Masked is
+
+   type Int_Vector is array (0 .. 3) of Integer_32;
+   pragma Machine_Attribute (Int_Vector, "vector_type");
+
+   type Mask_Vector is array (0 .. 3) of Unsigned_32;
+   pragma Machine_Attribute (Mask_Vector, "vector_type");
+
+   function Masked_Load
+     (Addr : Address; M : Mask_Vector; Passthru : Int_Vector)
+      return Int_Vector;
+   pragma Import (Intrinsic, Masked_Load, "__builtin_vector_masked_load");
+
+   procedure Masked_Store (Addr : Address; M : Mask_Vector; V : Int_Vector);
+   pragma Import (Intrinsic, Masked_Store, "__builtin_vector_masked_store");
+
+   function Opaque (M : Mask_Vector) return Mask_Vector;
+   pragma No_Inline (Opaque);
+   --  Return M, hiding its value from the optimizer
+
+   procedure Check (Name : String; Got, Want : Int_Vector);
+   --  Report whether Got is Want
+
+   Failed : Boolean := False;
+
+   ------------
+   -- Opaque --
+   ------------
+
+   function Opaque (M : Mask_Vector) return Mask_Vector is (M);
+
+   -----------
+   -- Check --
+   -----------
+
+   procedure Check (Name : String; Got, Want : Int_Vector) is
+   begin
+      if Got /= Want then
+         Put_Line ("FAILED: " & Name);
+         Failed := True;
+      end if;
+   end Check;
+
+   Memory   : aliased Int_Vector  := [1, 2, 3, 4];
+   Passthru : constant Int_Vector := [-1, -2, -3, -4];
+   Value    : constant Int_Vector := [10, 20, 30, 40];
+
+begin
+   Check ("load none",
+          Masked_Load (Memory'Address, Opaque ([0, 0, 0, 0]), Passthru),
+          Passthru);
+   Check ("load all",
+          Masked_Load (Memory'Address, Opaque ([1, 1, 1, 1]), Passthru),
+          Memory);
+   Check ("load some",
+          Masked_Load (Memory'Address, Opaque ([16#8000_0000#, 0, 7, 0]),
+                       Passthru),
+          [1, -2, 3, -4]);
+
+   Masked_Store (Memory'Address, Opaque ([0, 0, 0, 0]), Value);
+   Check ("store none", Memory, [1, 2, 3, 4]);
+   Masked_Store (Memory'Address, Opaque ([0, 5, 0, 16#FFFF_FFFF#]), Value);
+   Check ("store some", Memory, [1, 20, 3, 40]);
+   Masked_Store (Memory'Address, Opaque ([1, 1, 1, 1]), Value);
+   Check ("store all", Memory, Value);
+
+   if not Failed then
+      Put_Line ("PASSED");
+   end if;
+end Vector_Masked;
@@ -0,0 +1,123 @@
+------------------------------------------------------------------------------
+--                             G N A T - L L V M                            --
+--                                                                          --
+--                       Copyright (C) 2023, AdaCore                        --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.  You should have  received  a copy of the GNU --
+-- General  Public  License  distributed  with  this  software;   see  file --
+-- COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy --
+-- of the license.                                                          --
+------------------------------------------------------------------------------
+
+--  Test the __builtin_vector_reduce operations, which combine all the
+--  lanes of a vector, on signed, unsigned and floating-point lanes. The
+--  floating-point values are chosen so that the result doesn't depend on
+--  the order in which the lanes are combined.
+
+with Ada.Text_IO; use Ada.Text_IO;
+with Interfaces;  use Interfaces;
+
+procedure Vector_Reduce is
+
+   type Int_Vector is array (1 .. 8) of Integer_16;
+   pragma Machine_Attribute (Int_Vector, "vector_type");
+
+   type Uns_Vector is array (1 .. 4) of Unsigned_64;
+   pragma Machine_Attribute (Uns_Vector, "vector_type");
+
+   type Flt_Vector is array (1 .. 4) of IEEE_Float_32;
+   pragma Machine_Attribute (Flt_Vector, "vector_type");
+
+   function Add (A : Int_Vector) return Integer_16;
+   function Mul (A : Int_Vector) return Integer_16;
+   function Min (A : Int_Vector) return Integer_16;
+   function Max (A : Int_Vector) return Integer_16;
+   pragma Import (Intrinsic, Add, "__builtin_vector_reduce_add");
+   pragma Import (Intrinsic, Mul, "__builtin_vector_reduce_mul");
+   pragma Import (Intrinsic, Min, "__builtin_vector_reduce_min");
+   pragma Import (Intrinsic, Max, "__builtin_vector_reduce_max");
+
+   function And_R (A : Uns_Vector) return Unsigned_64;
+   function Or_R (A : Uns_Vector) return Unsigned_64;
+   function Xor_R (A : Uns_Vector) return Unsigned_64;
+   function Min (A : Uns_Vector) return Unsigned_64;
+   function Max (A : Uns_Vector) return Unsigned_64;
+   pragma Import (Intrinsic, And_R, "__builtin_vector_reduce_and");
+   pragma Import (Intrinsic, Or_R, "__builtin_vector_reduce_or");
+   pragma Import (Intrinsic, Xor_R, "__builtin_vector_reduce_xor");
+   pragma Import (Intrinsic, Min, "__builtin_vector_reduce_min");
+   pragma Import (Intrinsic, Max, "__builtin_vector_reduce_max");
+
+   function Add (A : Flt_Vector) return IEEE_Float_32;
+   function Mul (A : Flt_Vector) return IEEE_Float_32;
+   function Min (A : Flt_Vector) return IEEE_Float_32;
+   function Max (A : Flt_Vector) return IEEE_Float_32;
+   pragma Import (Intrinsic, Add, "__builtin_vector_reduce_add");
+   pragma Import (Intrinsic, Mul, "__builtin_vector_reduce_mul");
+   pragma Import (Intrinsic, Min, "__builtin_vector_reduce_min");
+   pragma Import (Intrinsic, Max, "__builtin_vector_reduce_max");
+
+   function Opaque (V : Int_Vector) return Int_Vector;
+   function Opaque (V : Uns_Vector) return Uns_Vector;
+   function Opaque (V : Flt_Vector) return Flt_Vector;
+   pragma No_Inline (Opaque);
+   --  Return V, hiding its value from the optimizer
+
+   procedure Check (Name : String; OK : Boolean);
+   --  Report a failure of the test Name unless OK
+
+   Failed : Boolean := False;
+
+   ------------
+   -- Opaque --
+   ------------
+
+   function Opaque (V : Int_Vector) return Int_Vector is (V);
+   function Opaque (V : Uns_Vector) return Uns_Vector is (V);
+   function Opaque (V : Flt_Vector) return Flt_Vector is (V);
+
+   -----------
+   -- Check --
+   -----------
+
+   procedure Check (Name : String; OK : Boolean) is
+   begin
+      if not OK then
+         Put_Line ("FAILED: " & Name);
+         Failed := True;
+      end if;
+   end Check;
+
+   IA : constant Int_Vector := Opaque ([3, -1, 4, -1, 5, -9, 2, 6]);
+   UA : constant Uns_Vector :=
+     Opaque ([16#FF00_FF00_0000_00FF#, 16#0F0F_0000_1234_00F0#,
+              16#F000_0000_FFFF_FFFF#, 16#FFFF_FFFF_FFFF_FFF0#]);
+   FA : constant Flt_Vector := Opaque ([0.5, -4.0, 2.0, 0.25]);
+
+begin
+   Check ("signed add", Add (IA) = 9);
+   Check ("signed mul", Mul (IA) = -6480);
+   Check ("signed min", Min (IA) = -9);
+   Check ("signed max", Max (IA) = 6);
+
+   Check ("and", And_R (UA) = (UA (1) and UA (2) and UA (3) and UA (4)));
+   Check ("or", Or_R (UA) = (UA (1) or UA (2) or UA (3) or UA (4)));
+   Check ("xor", Xor_R (UA) = (UA (1) xor UA (2) xor UA (3) xor UA (4)));
+   Check ("unsigned min", Min (UA) = 16#0F0F_0000_1234_00F0#);
+   Check ("unsigned max", Max (UA) = 16#FFFF_FFFF_FFFF_FFF0#);
+
+   Check ("float add", Add (FA) = -1.25);
+   Check ("float mul", Mul (FA) = -1.0);
+   Check ("float min", Min (FA) = -4.0);
+   Check ("float max", Max (FA) = 2.0);
+
+   if not Failed then
+      Put_Line ("PASSED");
+   end if;
+end Vector_Reduce;
@@ -0,0 +1,163 @@
+------------------------------------------------------------------------------
+--                             G N A T - L L V M                            --
+--                                                                          --
+--                       Copyright (C) 2023, AdaCore                        --
+--                                                                          --
+-- This is free software;  you can redistribute it  and/or modify it  under --
+-- terms of the  GNU General Public License as published  by the Free Soft- --
+-- ware  Foundation;  either version 3,  or (at your option) any later ver- --
+-- sion.  This software is distributed in the hope  that it will be useful, --
+-- but WITHOUT ANY WARRANTY;  without even the implied warranty of MERCHAN- --
+-- TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public --
+-- License for  more details.  You should have  received  a copy of the GNU --
+-- General  Public  License  distributed  with  this  software;   see  file --
+-- COPYING3.  If not, go to http://www.gnu.org/licenses for a complete copy --
+-- of the license.                                                          --
+------------------------------------------------------------------------------
+
+--  Test __builtin_vector_shuffle when compiling to an object file, where
+--  we use LLVM vectors, with both a constant mask, for which LLVM makes a
+--  shufflevector, and a mask only known at run time, for which the result
+--  vector is built up one lane at a time. We also check masks whose
+--  components are too narrow to hold twice the number of lanes as signed
+--  values and masks with components wider than 32 bits.
+
+with Ada.Text_IO; use Ada.Text_IO;
+with Interfaces;  use Interfaces;
+
+procedure Vector_Shuffle is
+
+   type Int_Vector is array (0 .. 3) of Integer_32;
+   pragma Machine_Attribute (Int_Vector, "vector_type");
+
+   type Mask_Vector is array (0 .. 3) of Unsigned_32;
+   pragma Machine_Attribute (Mask_Vector, "vector_type");
+
+   function Shuffle (A, B : Int_Vector; M : Mask_Vector) return Int_Vector;
+   pragma Import (Intrinsic, Shuffle, "__builtin_vector_shuffle");
+
+   type Byte_Vector is array (0 .. 63) of Unsigned_8;
+   pragma Machine_Attribute (Byte_Vector, "vector_type");
+
+   type Byte_Mask is array (0 .. 63) of Integer_8;
+   pragma Machine_Attribute (Byte_Mask, "vector_type");
+
+   function Shuffle (A, B : Byte_Vector; M : Byte_Mask) return Byte_Vector;
+   pragma Import (Intrinsic, Shuffle, "__builtin_vector_shuffle");
+
+   type Pair_Vector is array (0 .. 1) of Integer_32;
+   pragma Machine_Attribute (Pair_Vector, "vector_type");
+
+   type Wide_Mask is array (0 .. 1) of Unsigned_64;
+   pragma Machine_Attribute (Wide_Mask, "vector_type");
+
+   function Shuffle (A, B : Pair_Vector; M : Wide_Mask) return Pair_Vector;
+   pragma Import (Intrinsic, Shuffle, "__builtin_vector_shuffle");
+
+   function Expected (A, B : Int_Vector; M : Mask_Vector) return Int_Vector;
+   --  What Shuffle should return, computed without the builtin
+
+   function Opaque (M : Mask_Vector) return Mask_Vector;
+   function Opaque (M : Byte_Mask) return Byte_Mask;
+   function Opaque (M : Wide_Mask) return Wide_Mask;
+   pragma No_Inline (Opaque);
+   --  Return M, hiding its value from the optimizer
+
+   procedure Check (Name : String; Got, Want : Int_Vector);
+   --  Report whether Got is Want
+
+   A : constant Int_Vector := [10, 11, 12, 13];
+   B : constant Int_Vector := [20, 21, 22, 23];
+
+   Failed : Boolean := False;
+
+   --------------
+   -- Expected --
+   --------------
+
+   function Expected (A, B : Int_Vector; M : Mask_Vector) return Int_Vector
+   is
+      Result : Int_Vector;
+      Idx    : Unsigned_32;
+
+   begin
+      for J in M'Range loop
+         Idx := M (J) mod 8;
+         Result (J) := (if Idx >= 4 then B (Integer (Idx - 4))
+                        else A (Integer (Idx)));
+      end loop;
+
+      return Result;
+   end Expected;
+
+   ------------
+   -- Opaque --
+   ------------
+
+   function Opaque (M : Mask_Vector) return Mask_Vector is (M);
+   function Opaque (M : Byte_Mask) return Byte_Mask is (M);
+   function Opaque (M : Wide_Mask) return Wide_Mask is (M);
+
+   -----------
+   -- Check --
+   -----------
+
+   procedure Check (Name : String; Got, Want : Int_Vector) is
+   begin
+      if Got /= Want then
+         Put_Line ("FAILED: " & Name);
+         Failed := True;
+      end if;
+   end Check;
+
+   Masks : constant array (1 .. 4) of Mask_Vector :=
+     [[0, 1, 2, 3], [7, 6, 5, 4], [0, 4, 1, 5], [8, 13, 18, 31]];
+
+   --  Lane J of BA is J and of BB is J + 64, so each lane of the result
+   --  of a shuffle of them is the index it was taken from. The lanes of
+   --  BM run through the values of a byte in steps of four, including
+   --  negative ones, which are taken modulo 128 as unsigned values.
+
+   BA : constant Byte_Vector := [for J in Byte_Vector'Range => Unsigned_8 (J)];
+   BB : constant Byte_Vector :=
+     [for J in Byte_Vector'Range => Unsigned_8 (J + 64)];
+   BM : constant Byte_Mask   :=
+     Opaque ([for J in Byte_Mask'Range => Integer_8 (J * 4 mod 256 - 128)]);
+
+   --  Only the remainder of the lanes of WM modulo four matters
+
+   PA : constant Pair_Vector := [1, 2];
+   PB : constant Pair_Vector := [3, 4];
+   WM : constant Wide_Mask   := Opaque ([2**32 + 3, 2**63 + 1]);
+
+begin
+   Check ("constant mask",
+          Shuffle (A, B, [3, 5, 0, 6]), Expected (A, B, [3, 5, 0, 6]));
+
+   for M of Masks loop
+      Check ("variable mask" & M (0)'Image & M (1)'Image & M (2)'Image
+             & M (3)'Image,
+             Shuffle (A, B, Opaque (M)), Expected (A, B, M));
+   end loop;
+
+   declare
+      Got : constant Byte_Vector := Shuffle (BA, BB, BM);
+
+   begin
+      for J in Got'Range loop
+         if Got (J) /= Unsigned_8 ((J * 4 mod 256 - 128) mod 128) then
+            Put_Line ("FAILED: byte mask lane" & J'Image);
+            Failed := True;
+         end if;
+      end loop;
+   end;
+
+   if Shuffle (PA, PB, WM) /= [4, 2] then
+      Put_Line ("FAILED: wide mask");
+      Failed := True;
+   end if;
+
+   if not Failed then
+      Put_Line ("PASSED");
+   end if;
+end Vector_Shuffle;
@@ -0,0 +1,89 @@
+/*****************************************************************************
+ *                                                                           *
+ *                            GNATPROVE COMPONENTS                           *
+ *                                                                           *
+ *                       F I L E _ I D E N T I T Y _ C                       *
+ *                                                                           *
+ *                            C Implementation file                          *
+ *                                                                           *
+ *                         Copyright (C) 2024, AdaCore                       *
+ *                                                                           *
+ * gnatprove is  free  software;  you can redistribute it and/or  modify it  *
+ * under terms of the  GNU General Public License as published  by the Free  *
+ * Software  Foundation;  either version 3,  or (at your option)  any later  *
+ * version.  gnatprove is distributed  in the hope that  it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHAN-  *
+ * TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public  *
+ * License for  more details.  You should have  received  a copy of the GNU  *
+ * General Public License  distributed with  gnatprove;  see file COPYING3.  *
+ * If not,  go to  http://www.gnu.org/licenses  for a complete  copy of the  *
+ * license.                                                                  *
+ *                                                                           *
+ * gnatprove is maintained by AdaCore (http://www.adacore.com)               *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef _WIN32
+
+/* For st_mtim and clock_gettime.  macOS has st_mtimespec instead, which
+   defining this would hide.  */
+#if !defined (__APPLE__) && !defined (_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+
+#ifdef __APPLE__
+#define MTIME(st) ((st).st_mtimespec)
+#define CTIME(st) ((st).st_ctimespec)
+#else
+#define MTIME(st) ((st).st_mtim)
+#define CTIME(st) ((st).st_ctim)
+#endif
+
+/* Seconds after which a file that wasn't changed is considered stable: any
+   later change to it will give it a different modification or status
+   change time, even with timestamps of coarse granularity.  */
+#define STABLE_DELAY 2
+
+static long long nanoseconds (struct timespec t) {
+  return (long long) t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+/* Get the identity of the file PATH: its device and inode numbers, its
+   size, and its modification and status change times in nanoseconds.
+   Also say whether it's stable.  Return 0 on success.  */
+
+int file_identity (const char *path, long long *dev, long long *ino,
+                   long long *size, long long *mtime, long long *ctime,
+                   int *stable) {
+  struct stat st;
+  struct timespec now;
+
+  if (stat (path, &st) != 0 || clock_gettime (CLOCK_REALTIME, &now) != 0)
+    return -1;
+
+  *dev = (long long) st.st_dev;
+  *ino = (long long) st.st_ino;
+  *size = (long long) st.st_size;
+  *mtime = nanoseconds (MTIME (st));
+  *ctime = nanoseconds (CTIME (st));
+  *stable = MTIME (st).tv_sec + STABLE_DELAY <= now.tv_sec
+    && CTIME (st).tv_sec + STABLE_DELAY <= now.tv_sec;
+  return 0;
+}
+
+#else
+
+/* Inode numbers and status change times aren't meaningful on Windows, so
+   files have no identity there.  */
+
+int file_identity (const char *path, long long *dev, long long *ino,
+                   long long *size, long long *mtime, long long *ctime,
+                   int *stable) {
+  return -1;
+}
+
+#endif
@@ -22,31 +22,165 @@
 --
 -------------------------------------------------------------------------------
 
-with Ada.Directories; use Ada.Directories;
+with Ada.Calendar;    use Ada.Calendar;
+with Ada.Containers.Indefinite_Vectors;
+with Ada.IO_Exceptions;
 with Call;            use Call;
 
 package body Filecache_Client is
 
+   --  Entries are stored in a two-level directory layout: the entry for a
+   --  key is in subdirectory K1/K2 of the cache directory, where K1 and K2
+   --  are the first two pairs of characters of the key. The keys are hex
+   --  digests, so this spreads entries over 65536 directories and keeps
+   --  each of them small even with millions of entries. Entries of caches
+   --  written with the flat layout of earlier versions are still found.
+
+   --  When the size of the cache is limited, each of the 256 directories
+   --  K1 gets an equal share of the limit, which Set enforces for the one
+   --  in which it stores an entry. Since the keys are uniformly
+   --  distributed, this keeps the size of the whole cache close to the
+   --  limit while only looking at a small part of it. The share of a
+   --  directory K1/K2 would be too small to hold more than one entry
+   --  unless the limit is huge. Get marks the entries it finds as used by
+   --  updating their modification time.
+
+   Group_Count : constant := 256;
+   --  The number of directories K1
+
+   function Shard_Dir (Conn : Filecache; Key : String) return String;
+   --  Return the directory in which the entry for Key is stored
+
+   procedure Prune (Conn : Filecache; Dir : String);
+   --  If the entries in the subdirectories of the directory K1 Dir take
+   --  more than its share of the size limit of the cache, remove the least
+   --  recently used ones until they take at most three quarters of it.
+
    ----------
    -- Init --
    ----------
 
-   function Init (Dir : String) return Filecache is
+   function Init (Dir : String; Max_Size : File_Size := 0) return Filecache
+   is
    begin
-      return Filecache'(Dir => new String'(Dir));
+      return Filecache'(Dir => new String'(Dir), Max_Size => Max_Size);
    end Init;
 
+   -----------
+   -- Prune --
+   -----------
+
+   procedure Prune (Conn : Filecache; Dir : String) is
+
+      type Cache_Entry (Length : Natural) is record
+         Name  : String (1 .. Length);
+         Size  : File_Size;
+         Mtime : Time;
+      end record;
+
+      function Older (Left, Right : Cache_Entry) return Boolean is
+        (Left.Mtime < Right.Mtime);
+
+      package Entry_Vectors is new Ada.Containers.Indefinite_Vectors
+        (Positive, Cache_Entry);
+
+      package Entry_Sorting is new Entry_Vectors.Generic_Sorting (Older);
+
+      procedure Add_Entries (Shard : Directory_Entry_Type);
+      --  Add the entries of the directory Shard to Entries
+
+      Share   : constant File_Size := Conn.Max_Size / Group_Count;
+      Entries : Entry_Vectors.Vector;
+      Total   : File_Size := 0;
+      Unused  : Boolean;
+
+      -----------------
+      -- Add_Entries --
+      -----------------
+
+      procedure Add_Entries (Shard : Directory_Entry_Type) is
+
+         procedure Add_Entry (Item : Directory_Entry_Type);
+         --  Add the entry Item to Entries, unless it's a temporary file,
+         --  being written by another client that will rename it.
+
+         ---------------
+         -- Add_Entry --
+         ---------------
+
+         procedure Add_Entry (Item : Directory_Entry_Type) is
+            Name : constant String := Full_Name (Item);
+         begin
+            if Extension (Name) /= "tmp" then
+               Entries.Append
+                 (Cache_Entry'(Length => Name'Length,
+                               Name   => Name,
+                               Size   => Size (Item),
+                               Mtime  => Modification_Time (Item)));
+               Total := Total + Size (Item);
+            end if;
+         end Add_Entry;
+
+         Name : constant String := Simple_Name (Shard);
+
+      begin
+         if Name /= "." and then Name /= ".." then
+            Search (Full_Name (Shard), "",
+                    [Ordinary_File => True, others => False],
+                    Add_Entry'Access);
+         end if;
+      end Add_Entries;
+
+   --  Start of processing for Prune
+
+   begin
+      Search (Dir, "", [Directory => True, others => False],
+              Add_Entries'Access);
+
+      if Total <= Share then
+         return;
+      end if;
+
+      --  Keep at least the most recent entry, which may be the one that
+      --  our caller just stored. Another client may be pruning the same
+      --  directories, so an entry may already be gone.
+
+      Entry_Sorting.Sort (Entries);
+      for E of Entries loop
+         exit when Total <= Share / 4 * 3
+           or else E.Name = Entries.Last_Element.Name;
+         Delete_File (E.Name, Unused);
+         Total := Total - E.Size;
+      end loop;
+
+   exception
+      when Ada.IO_Exceptions.Name_Error | Ada.IO_Exceptions.Use_Error =>
+         null;
+   end Prune;
+
+   ---------------
+   -- Shard_Dir --
+   ---------------
+
+   function Shard_Dir (Conn : Filecache; Key : String) return String is
+     (if Key'Length <= 4 then Conn.Dir.all
+      else Compose (Compose (Conn.Dir.all,
+                             Key (Key'First .. Key'First + 1)),
+                    Key (Key'First + 2 .. Key'First + 3)));
+
    ---------
    -- Set --
    ---------
 
    procedure Set (Conn : Filecache; Key : String; Value : String) is
-      Prev_Dir : constant String := Current_Directory;
-      Fn       : constant String := Compose (Conn.Dir.all, Key);
-      FD       : File_Descriptor;
-      Name     : String_Access;
-      Written  : Integer;
-      Unused   : Boolean;
+      Dir     : constant String := Shard_Dir (Conn, Key);
+      Fn      : constant String := Compose (Dir, Key);
+      PID     : constant String := Integer'Image (Get_Process_Id);
+      Tmp     : constant String :=
+        Fn & "." & PID (PID'First + 1 .. PID'Last) & ".tmp";
+      FD      : File_Descriptor;
+      Written : Integer;
+      Success : Boolean;
    begin
       --  We first write to a temporary file, then rename the file to the
       --  target filename. This should protect against:
@@ -58,25 +192,43 @@ package body Filecache_Client is
       --      the rename (renames last), as both should contain the same
       --      content.
 
-      --  Renaming doesn't work across devices, so it's safer to create the
-      --  temp file in the same directory. This is achieved by first switching
-      --  directories.
+      --  Renaming doesn't work across devices, so the temp file is created
+      --  next to the target file. Its name contains our process id, so it
+      --  can't clash with that of another client writing the same entry.
+
+      if not Exists (Dir) then
+         begin
+            Create_Path (Dir);
+         exception
 
-      Set_Directory (Conn.Dir.all);
+            --  Another client may have created the directory at the same
+            --  time as us.
+
+            when Ada.IO_Exceptions.Use_Error =>
+               if not Exists (Dir) then
+                  return;
+               end if;
+         end;
+      end if;
+
+      FD := Create_File (Tmp, Binary);
+      if FD = Invalid_FD then
+         return;
+      end if;
 
-      Create_Temp_File (FD, Name);
       Written := Write (FD, Value (Value'First)'Address, Value'Length);
-      Close (FD);
-      if Written /= Value'Length then
-         --  some error happened
-         Delete_File (Name.all, Unused);
-         goto Cleanup;
+      Close (FD, Success);
+      if Written = Value'Length and then Success then
+         Rename_File (Tmp, Fn, Success);
+      else
+         Success := False;
       end if;
-      Rename_File (Name.all, Fn, Unused);
 
-      << Cleanup >>
-      Free (Name);
-      Set_Directory (Prev_Dir);
+      if not Success then
+         Delete_File (Tmp, Success);
+      elsif Conn.Max_Size /= 0 and then Key'Length > 4 then
+         Prune (Conn, Containing_Directory (Dir));
+      end if;
    end Set;
 
    ---------
@@ -84,13 +236,27 @@ package body Filecache_Client is
    ---------
 
    function Get (Conn : Filecache; Key : String) return String is
-      File : constant String := Compose (Conn.Dir.all, Key);
+      Fn : constant String := Compose (Shard_Dir (Conn, Key), Key);
    begin
-      if Exists (File) then
-         return Read_File_Into_String (File);
-      else
-         return "";
-      end if;
+      return Result : constant String := Read_File_Into_String (Fn) do
+
+         --  Mark the entry as recently used, so that Prune keeps it
+
+         if Conn.Max_Size /= 0 then
+            Set_File_Last_Modify_Time_Stamp (Fn, Current_Time);
+         end if;
+      end return;
+   exception
+      when Ada.IO_Exceptions.Name_Error =>
+         declare
+            Flat : constant String := Compose (Conn.Dir.all, Key);
+         begin
+            if Key'Length > 4 and then Exists (Flat) then
+               return Read_File_Into_String (Flat);
+            else
+               return "";
+            end if;
+         end;
    end Get;
 
    -----------
@@ -0,0 +1,178 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                            GNATPROVE COMPONENTS                          --
+--                                                                          --
+--                  L A Y E R E D _ C A C H E _ C L I E N T                 --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+-------------------------------------------------------------------------------
+--
+-- Copyright (c) 2024, NeXTech Corporation. All rights reserved.
+-- DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+--
+-- This code is distributed in the hope that it will be useful, but WITHOUT
+-- ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+-- FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+-- version 2 for more details (a copy is included in the LICENSE file that
+-- accompanied this code).
+--
+-- Author(-s): Tunjay Akbarli (tunjayakbarli@it-gss.com)
+--             Tural Ghuliev (turalquliyev@it-gss.com)
+--
+-------------------------------------------------------------------------------
+
+with Ada.Unchecked_Deallocation;
+with Memcache_Client;
+
+package body Layered_Cache_Client is
+
+   procedure Free is new Ada.Unchecked_Deallocation
+     (Cache'Class, Cache_Access);
+
+   procedure Free is new Ada.Unchecked_Deallocation
+     (Remote_Tier, Remote_Tier_Access);
+
+   function Remote (Conn : Layered_Cache) return Cache_Access;
+   --  @param Conn a layered cache
+   --  @return the connection to the memcached server of Conn, connecting to
+   --    it if we haven't tried yet, or null if we can't use the server
+
+   procedure Drop_Remote (Conn : Layered_Cache);
+   --  @param Conn a layered cache whose connection to the memcached server
+   --    failed
+   --  Close that connection and go on without the server
+
+   ----------
+   -- Init --
+   ----------
+
+   function Init
+     (Local    : Cache'Class;
+      Hostname : String;
+      Port     : Port_Type) return Layered_Cache is
+   begin
+      return Layered_Cache'
+        (Local  => new Cache'Class'(Local),
+         Remote => new Remote_Tier'(Length   => Hostname'Length,
+                                    Hostname => Hostname,
+                                    Port     => Port,
+                                    Tried    => False,
+                                    Conn     => null));
+   end Init;
+
+   ------------
+   -- Remote --
+   ------------
+
+   function Remote (Conn : Layered_Cache) return Cache_Access is
+      Tier : Remote_Tier renames Conn.Remote.all;
+   begin
+      if not Tier.Tried then
+         Tier.Tried := True;
+         Tier.Conn := new Cache'Class'
+           (Memcache_Client.Init (Tier.Hostname, Tier.Port));
+      end if;
+
+      return Tier.Conn;
+
+   exception
+      when Socket_Error | Host_Error =>
+         return null;
+   end Remote;
+
+   -----------------
+   -- Drop_Remote --
+   -----------------
+
+   procedure Drop_Remote (Conn : Layered_Cache) is
+   begin
+      begin
+         Conn.Remote.Conn.Close;
+      exception
+         when Socket_Error =>
+            null;
+      end;
+
+      Free (Conn.Remote.Conn);
+   end Drop_Remote;
+
+   ---------
+   -- Set --
+   ---------
+
+   procedure Set
+     (Conn  : Layered_Cache;
+      Key   : String;
+      Value : String)
+   is
+      Remote_Conn : Cache_Access;
+   begin
+      Conn.Local.Set (Key, Value);
+      Remote_Conn := Remote (Conn);
+
+      if Remote_Conn /= null then
+         Remote_Conn.Set (Key, Value);
+      end if;
+
+   exception
+      when Socket_Error =>
+         Drop_Remote (Conn);
+   end Set;
+
+   ---------
+   -- Get --
+   ---------
+
+   function Get (Conn : Layered_Cache; Key : String) return String is
+      Local_Value : constant String := Conn.Local.Get (Key);
+      Remote_Conn : Cache_Access;
+
+   begin
+      if Local_Value'Length /= 0 then
+         return Local_Value;
+      end if;
+
+      Remote_Conn := Remote (Conn);
+
+      if Remote_Conn = null then
+         return "";
+      end if;
+
+      --  On a miss in the local tier, back-fill it with the value of the
+      --  remote tier, if any, so that the next lookup of Key is local.
+
+      declare
+         Remote_Value : constant String := Remote_Conn.Get (Key);
+      begin
+         if Remote_Value'Length /= 0 then
+            Conn.Local.Set (Key, Remote_Value);
+         end if;
+
+         return Remote_Value;
+      end;
+
+   exception
+      when Socket_Error =>
+         Drop_Remote (Conn);
+         return "";
+   end Get;
+
+   -----------
+   -- Close --
+   -----------
+
+   procedure Close (Conn : in out Layered_Cache) is
+   begin
+      Conn.Local.Close;
+      Free (Conn.Local);
+
+      if Conn.Remote.Conn /= null then
+         Conn.Remote.Conn.Close;
+         Free (Conn.Remote.Conn);
+      end if;
+
+      Free (Conn.Remote);
+   end Close;
+
+end Layered_Cache_Client;
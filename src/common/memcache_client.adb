@@ -37,15 +37,14 @@ package body Memcache_Client is
      Ada.Characters.Latin_1.CR &
      Ada.Characters.Latin_1.LF;
 
-   function Read_Stop_When_End_Marker
-     (Conn       : Cache_Connection;
-      End_Marker : String)
-      return String;
+   Value_Prefix : constant String := "VALUE ";
+   --  The start of the first line of the answer to a get for a key that
+   --  has a value
+
+   procedure Receive (Conn : Cache_Connection; Buf : in out Unbounded_String);
    --  @param Conn the connection from which to read
-   --  @param End_Marker when the read text ends with this marker, stop
-   --    reading. Reading will *not* stop if the end marker appears somewhere
-   --    inside a message. But this shouldn't happen in regular connections.
-   --  @return the read text
+   --  @param Buf the text read so far, to which we append what we read
+   --  Raise Socket_Error if the server closed the connection.
 
    ----------
    -- Init --
@@ -68,6 +67,14 @@ package body Memcache_Client is
 
       pragma Assert (Status);
 
+      --  We send a request in several pieces and then wait for the answer,
+      --  so Nagle's algorithm would delay the last piece until the server
+      --  acknowledges the first, which it may itself delay.
+
+      Set_Socket_Option (Result.Sock,
+                         IP_Protocol_For_TCP_Level,
+                         (Name => No_Delay, Enabled => True));
+
       Connect_Socket (Result.Sock,
                       (Family => Family_Inet,
                        Addr   => Addresses (Host),
@@ -76,33 +83,28 @@ package body Memcache_Client is
       return Result;
    end Init;
 
-   -------------------------------
-   -- Read_Stop_When_End_Marker --
-   -------------------------------
+   -------------
+   -- Receive --
+   -------------
 
-   function Read_Stop_When_End_Marker
-     (Conn : Cache_Connection;
-      End_Marker : String)
-      return String
+   procedure Receive (Conn : Cache_Connection; Buf : in out Unbounded_String)
    is
-      Buf : Ada.Streams.Stream_Element_Array (1 .. 1024);
-      Result : Unbounded_String := Null_Unbounded_String;
+      Data : Ada.Streams.Stream_Element_Array (1 .. 65536);
       Last : Ada.Streams.Stream_Element_Offset;
    begin
-      loop
-         Receive_Socket (Conn.Sock, Buf, Last);
-         declare
-            Read_Str : String (Integer (Buf'First) .. Integer (Last));
-         begin
-            for I in Buf'First .. Last loop
-               Read_Str (Integer (I)) := Character'Val (Buf (I));
-            end loop;
-            Append (Result, Read_Str);
-            exit when Tail (Result, End_Marker'Length) = End_Marker;
-         end;
-      end loop;
-      return To_String (Result);
-   end Read_Stop_When_End_Marker;
+      Receive_Socket (Conn.Sock, Data, Last);
+      if Last < Data'First then
+         raise Socket_Error with "connection closed by memcached server";
+      end if;
+
+      declare
+         Read_Str : String (1 .. Integer (Last));
+         for Read_Str'Address use Data'Address;
+         --  A fake string directly mapped onto the data received
+      begin
+         Append (Buf, Read_Str);
+      end;
+   end Receive;
 
    ---------
    -- Set --
@@ -116,10 +118,13 @@ package body Memcache_Client is
       Len : constant Natural := Value'Length;
    begin
 
-      --  Hardcoding unused flag and expiration values
+      --  Hardcoding unused flag and expiration values. We don't wait for
+      --  the server to answer, since we would ignore a failure to store the
+      --  value anyway (e.g. when the value object is too large), so a store
+      --  costs no round trip.
 
       String'Write (Conn.Stream, "set " & Key & " 0 0" &
-                      Natural'Image (Len) & CRLF);
+                      Natural'Image (Len) & " noreply" & CRLF);
 
       --  The stored value might be arbitrarily large, so we need to send it
       --  separately, i.e. without concatenating with the "set ..." command
@@ -128,28 +133,6 @@ package body Memcache_Client is
 
       String'Write (Conn.Stream, Value);
       String'Write (Conn.Stream, CRLF);
-
-      declare
-         Answer : constant String := Read_Stop_When_End_Marker (Conn, CRLF);
-
-      begin
-         --  We expect the key-value pair to be stored
-
-         if Answer = "STORED" & CRLF then
-            null;
-
-         --  Silenlty ignore server-side errors, e.g. when the value object is
-         --  too large. ??? ideally such errors should be propagated to users
-
-         elsif Head (Answer, 13) = "SERVER_ERROR "
-           and then Tail (Answer, 2) = CRLF
-         then
-            null;
-
-         else
-            raise Program_Error;
-         end if;
-      end;
    end Set;
 
    ---------
@@ -157,18 +140,59 @@ package body Memcache_Client is
    ---------
 
    function Get (Conn : Cache_Connection; Key : String) return String is
+      Answer : Unbounded_String;
+      EOL    : Natural;
    begin
       String'Write (Conn.Stream, "get " & Key & CRLF);
+
+      --  The answer starts with a line that is either "END", if no value is
+      --  stored, or "VALUE <key> <flags> <bytes>". In the latter case, it
+      --  is followed by the value, a CRLF and a line containing "END". We
+      --  use the length in the first line to know when we have the whole
+      --  value rather than looking for the END marker, which might also
+      --  appear in the value.
+
+      loop
+         Receive (Conn, Answer);
+         EOL := Index (Answer, CRLF);
+         exit when EOL /= 0;
+      end loop;
+
+      if EOL = 4 and then Slice (Answer, 1, 3) = "END" then
+         return "";
+      end if;
+
+      --  Anything else than a value is an error. It may be the answer to
+      --  this request or to an earlier set, since the server reports errors
+      --  even for requests that asked for no reply. We can't tell which,
+      --  so we can't trust what follows on the connection either.
+
       declare
-         Answer : constant String :=
-           Read_Stop_When_End_Marker (Conn, "END" & CRLF);
-         Start  : constant Integer := Ada.Strings.Fixed.Index (Answer, CRLF);
+         Header : constant String := Slice (Answer, 1, EOL - 1);
+         Last   : constant Natural :=
+           Index (Header, " ", Ada.Strings.Backward);
+         Len    : Natural;
       begin
-         --  We remove the first line from the output, as well as the last
-         --  line containing the END marker, and also the previous CRLF line
-         --  separator. The result may be empty.
+         if Head (Header, Value_Prefix'Length) /= Value_Prefix
+           or else Last = 0
+         then
+            raise Socket_Error with
+              "unexpected answer from memcached server: " & Header;
+         end if;
+
+         begin
+            Len := Natural'Value (Header (Last + 1 .. Header'Last));
+         exception
+            when Constraint_Error =>
+               raise Socket_Error with
+                 "invalid answer from memcached server: " & Header;
+         end;
+
+         while Length (Answer) < EOL + 1 + Len + CRLF'Length + 5 loop
+            Receive (Conn, Answer);
+         end loop;
 
-         return Answer (Start + 2 .. Answer'Last - 7);
+         return Slice (Answer, EOL + 2, EOL + 1 + Len);
       end;
    end Get;
 
@@ -0,0 +1,279 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                            GNATPROVE COMPONENTS                          --
+--                                                                          --
+--                        F A K E _ M E M C A C H E D                       --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+-------------------------------------------------------------------------------
+--
+-- Copyright (c) 2024, NeXTech Corporation. All rights reserved.
+-- DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+--
+-- This code is distributed in the hope that it will be useful, but WITHOUT
+-- ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+-- FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+-- version 2 for more details (a copy is included in the LICENSE file that
+-- accompanied this code).
+--
+-- Author(-s): Tunjay Akbarli (tunjayakbarli@it-gss.com)
+--             Tural Ghuliev (turalquliyev@it-gss.com)
+--
+-------------------------------------------------------------------------------
+
+with Ada.Characters.Latin_1;
+with Ada.Containers.Indefinite_Hashed_Maps;
+with Ada.IO_Exceptions;
+with Ada.Strings.Hash;
+with Ada.Strings.Unbounded; use Ada.Strings.Unbounded;
+with GNAT.String_Split;     use GNAT.String_Split;
+
+package body Fake_Memcached is
+
+   CRLF : constant String :=
+     Ada.Characters.Latin_1.CR &
+     Ada.Characters.Latin_1.LF;
+
+   package String_Maps is new Ada.Containers.Indefinite_Hashed_Maps
+     (Key_Type        => String,
+      Element_Type    => String,
+      Hash            => Ada.Strings.Hash,
+      Equivalent_Keys => "=");
+
+   Server_Port : Port_Type := No_Port;
+   --  The port on which the server listens, once started
+
+   Table : String_Maps.Map;
+   --  The values stored in the server, only accessed by task Server
+
+   function Read_Line (Stream : Stream_Access) return String;
+   --  @param Stream the stream of a connection
+   --  @return the next line read from Stream, without its CRLF
+   --  Raise Ada.IO_Exceptions.End_Error if the client closed the connection
+
+   function Read_Data
+     (Stream : Stream_Access;
+      Length : Natural) return Unbounded_String;
+   --  @param Stream the stream of a connection
+   --  @param Length the number of bytes to read
+   --  @return the next Length bytes read from Stream, after which we skip
+   --    the CRLF that ends the data
+
+   function Serve (Conn : Socket_Type) return Boolean;
+   --  @param Conn a connection to a client
+   --  @return False if the client asked us to shut down
+   --  Answer the requests of the client until it closes the connection
+
+   task Server is
+      entry Start (Port : out Port_Type);
+   end Server;
+
+   ---------------
+   -- Read_Data --
+   ---------------
+
+   function Read_Data
+     (Stream : Stream_Access;
+      Length : Natural) return Unbounded_String
+   is
+      Result : Unbounded_String;
+      Buffer : String (1 .. 4096);
+      Left   : Natural := Length;
+      EOL    : String (1 .. CRLF'Length);
+   begin
+      while Left > 0 loop
+         declare
+            Chunk : String renames
+              Buffer (1 .. Natural'Min (Left, Buffer'Length));
+         begin
+            String'Read (Stream, Chunk);
+            Append (Result, Chunk);
+            Left := Left - Chunk'Length;
+         end;
+      end loop;
+
+      String'Read (Stream, EOL);
+      return Result;
+   end Read_Data;
+
+   ---------------
+   -- Read_Line --
+   ---------------
+
+   function Read_Line (Stream : Stream_Access) return String is
+      Line : Unbounded_String;
+      C    : Character;
+   begin
+      loop
+         Character'Read (Stream, C);
+         Append (Line, C);
+         exit when C = CRLF (2) and then Length (Line) >= CRLF'Length
+           and then Element (Line, Length (Line) - 1) = CRLF (1);
+      end loop;
+
+      return Slice (Line, 1, Length (Line) - CRLF'Length);
+   end Read_Line;
+
+   -----------
+   -- Serve --
+   -----------
+
+   function Serve (Conn : Socket_Type) return Boolean is
+      Stream : Stream_Access := GNAT.Sockets.Stream (Conn);
+
+      procedure Answer (S : String);
+      --  Send S to the client
+
+      ------------
+      -- Answer --
+      ------------
+
+      procedure Answer (S : String) is
+      begin
+         String'Write (Stream, S);
+      end Answer;
+
+   begin
+      loop
+         declare
+            Line   : constant String := Read_Line (Stream);
+            Fields : Slice_Set;
+         begin
+            Create (Fields, Line, " ", Multiple);
+
+            if Line = "shutdown" then
+               Free (Stream);
+               return False;
+
+            elsif Slice (Fields, 1) = "get" and then Slice_Count (Fields) = 2
+            then
+               declare
+                  Key : constant String := Slice (Fields, 2);
+               begin
+                  if Key'Length > Max_Key_Size then
+                     Answer ("CLIENT_ERROR bad command line format" & CRLF);
+                  elsif Table.Contains (Key) then
+                     declare
+                        Value : constant String := Table.Element (Key);
+                     begin
+                        Answer ("VALUE " & Key & " 0"
+                                & Natural'Image (Value'Length) & CRLF);
+                        Answer (Value);
+                        Answer (CRLF & "END" & CRLF);
+                     end;
+                  else
+                     Answer ("END" & CRLF);
+                  end if;
+               end;
+
+            elsif Slice (Fields, 1) = "set"
+              and then Slice_Count (Fields) in 5 .. 6
+            then
+               declare
+                  Key      : constant String := Slice (Fields, 2);
+                  Length   : constant Natural :=
+                    Natural'Value (Slice (Fields, 5));
+                  No_Reply : constant Boolean :=
+                    Slice_Count (Fields) = 6
+                    and then Slice (Fields, 6) = "noreply";
+                  Value    : constant Unbounded_String :=
+                    Read_Data (Stream, Length);
+               begin
+
+                  --  Like memcached, we report errors even when asked not
+                  --  to reply.
+
+                  if Length > Max_Value_Size then
+                     Answer ("SERVER_ERROR object too large for cache"
+                             & CRLF);
+                  else
+                     Table.Include (Key, To_String (Value));
+                     if not No_Reply then
+                        Answer ("STORED" & CRLF);
+                     end if;
+                  end if;
+               end;
+
+            else
+               Answer ("ERROR" & CRLF);
+            end if;
+         end;
+      end loop;
+
+   exception
+      when Ada.IO_Exceptions.End_Error | Socket_Error =>
+         Free (Stream);
+         return True;
+   end Serve;
+
+   ------------
+   -- Server --
+   ------------
+
+   task body Server is
+      Listener : Socket_Type;
+      Address  : Sock_Addr_Type :=
+        (Family => Family_Inet,
+         Addr   => Loopback_Inet_Addr,
+         Port   => Any_Port);
+
+   begin
+      select
+         accept Start (Port : out Port_Type) do
+            Create_Socket (Listener);
+            Bind_Socket (Listener, Address);
+            Listen_Socket (Listener);
+            Address := Get_Socket_Name (Listener);
+            Port := Address.Port;
+         end Start;
+      or
+         terminate;
+      end select;
+
+      loop
+         declare
+            Conn  : Socket_Type;
+            Peer  : Sock_Addr_Type;
+            Go_On : Boolean;
+         begin
+            Accept_Socket (Listener, Conn, Peer);
+            Go_On := Serve (Conn);
+            Close_Socket (Conn);
+            exit when not Go_On;
+         end;
+      end loop;
+
+      Close_Socket (Listener);
+   end Server;
+
+   -----------
+   -- Start --
+   -----------
+
+   procedure Start (Port : out Port_Type) is
+   begin
+      Server.Start (Server_Port);
+      Port := Server_Port;
+   end Start;
+
+   ----------
+   -- Stop --
+   ----------
+
+   procedure Stop is
+      Sock   : Socket_Type;
+      Stream : Stream_Access;
+   begin
+      Create_Socket (Sock);
+      Connect_Socket (Sock,
+                      (Family => Family_Inet,
+                       Addr   => Loopback_Inet_Addr,
+                       Port   => Server_Port));
+      Stream := GNAT.Sockets.Stream (Sock);
+      String'Write (Stream, "shutdown" & CRLF);
+      Free (Stream);
+      Close_Socket (Sock);
+   end Stop;
+
+end Fake_Memcached;
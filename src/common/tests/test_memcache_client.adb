@@ -0,0 +1,150 @@
+------------------------------------------------------------------------------
+--                                                                          --
+--                            GNATPROVE COMPONENTS                          --
+--                                                                          --
+--                  T E S T _ M E M C A C H E _ C L I E N T                 --
+--                                                                          --
+--                                 B o d y                                  --
+--                                                                          --
+-------------------------------------------------------------------------------
+--
+-- Copyright (c) 2024, NeXTech Corporation. All rights reserved.
+-- DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+--
+-- This code is distributed in the hope that it will be useful, but WITHOUT
+-- ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+-- FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+-- version 2 for more details (a copy is included in the LICENSE file that
+-- accompanied this code).
+--
+-- Author(-s): Tunjay Akbarli (tunjayakbarli@it-gss.com)
+--             Tural Ghuliev (turalquliyev@it-gss.com)
+--
+-------------------------------------------------------------------------------
+
+with Ada.Characters.Latin_1;
+with Ada.Directories;
+with Ada.Text_IO;          use Ada.Text_IO;
+with Fake_Memcached;       use Fake_Memcached;
+with Filecache_Client;
+with GNAT.Sockets;         use GNAT.Sockets;
+with Layered_Cache_Client;
+with Memcache_Client;      use Memcache_Client;
+
+procedure Test_Memcache_Client is
+
+   --  Test the memcached client against Fake_Memcached: a miss, a hit, a
+   --  value containing the END marker, a value that takes several reads,
+   --  and errors, both in answer to a get and left by a set that asked for
+   --  no reply. A layered cache must turn the latter into a miss.
+
+   CRLF : constant String :=
+     Ada.Characters.Latin_1.CR &
+     Ada.Characters.Latin_1.LF;
+
+   Port     : Port_Type;
+   Failures : Natural := 0;
+
+   procedure Check (Success : Boolean; What : String);
+   --  @param Success whether the test passed
+   --  @param What a description of the test
+   --  Report What if Success is False
+
+   function Get_Fails (Conn : Cache_Connection; Key : String) return Boolean;
+   --  @param Conn a connection to the server
+   --  @param Key the key to look up
+   --  @return whether looking up Key raises Socket_Error
+
+   -----------
+   -- Check --
+   -----------
+
+   procedure Check (Success : Boolean; What : String) is
+   begin
+      if not Success then
+         Put_Line ("FAILED: " & What);
+         Failures := Failures + 1;
+      end if;
+   end Check;
+
+   ---------------
+   -- Get_Fails --
+   ---------------
+
+   function Get_Fails (Conn : Cache_Connection; Key : String) return Boolean
+   is
+   begin
+      declare
+         Unused : constant String := Conn.Get (Key);
+      begin
+         return False;
+      end;
+   exception
+      when Socket_Error =>
+         return True;
+   end Get_Fails;
+
+   With_End  : constant String := "a" & CRLF & "END" & CRLF & "b";
+   Large     : constant String (1 .. Max_Value_Size) := [others => 'x'];
+   Too_Large : constant String (1 .. Max_Value_Size + 1) := [others => 'x'];
+   Long_Key  : constant String (1 .. Max_Key_Size + 1) := [others => 'k'];
+
+begin
+   Start (Port);
+
+   declare
+      Conn : Cache_Connection := Init ("127.0.0.1", Port);
+   begin
+      Check (Conn.Get ("absent") = "", "miss");
+      Conn.Set ("key", "value");
+      Check (Conn.Get ("key") = "value", "hit");
+      Conn.Set ("with-end", With_End);
+      Check (Conn.Get ("with-end") = With_End, "value containing END");
+      Conn.Set ("large", Large);
+      Check (Conn.Get ("large") = Large, "value larger than a read");
+      Check (Conn.Get ("key") = "value", "hit after a large value");
+      Conn.Close;
+   end;
+
+   declare
+      Conn : Cache_Connection := Init ("127.0.0.1", Port);
+   begin
+      Check (Get_Fails (Conn, Long_Key), "error in answer to a get");
+      Conn.Close;
+   end;
+
+   declare
+      Conn : Cache_Connection := Init ("127.0.0.1", Port);
+   begin
+      Conn.Set ("too-large", Too_Large);
+      Check (Get_Fails (Conn, "key"), "error left by a set");
+      Conn.Close;
+   end;
+
+   declare
+      Dir  : constant String := "layered-cache";
+      Conn : Layered_Cache_Client.Layered_Cache;
+   begin
+      if Ada.Directories.Exists (Dir) then
+         Ada.Directories.Delete_Tree (Dir);
+      end if;
+      Ada.Directories.Create_Directory (Dir);
+
+      Conn := Layered_Cache_Client.Init
+        (Local    => Filecache_Client.Init (Dir),
+         Hostname => "127.0.0.1",
+         Port     => Port);
+      Check (Conn.Get ("key") = "value", "hit in the remote tier");
+      Conn.Set ("too-large", Too_Large);
+      Check (Conn.Get ("absent") = "", "error from the remote tier");
+      Check (Conn.Get ("too-large") = Too_Large, "hit in the local tier");
+      Check (Conn.Get ("key") = "value", "hit in the local tier after fill");
+      Conn.Close;
+   end;
+
+   Stop;
+
+   if Failures = 0 then
+      Put_Line ("PASSED");
+   end if;
+end Test_Memcache_Client;
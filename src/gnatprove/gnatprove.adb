@@ -69,6 +69,7 @@ with Ada.Environment_Variables;
 with Ada.Exceptions;   use Ada.Exceptions;
 with Ada.Strings.Unbounded;
 with Ada.Text_IO;      use Ada.Text_IO;
+with Cache_Client;
 with Call;             use Call;
 with Configuration;    use Configuration;
 with GNAT.OS_Lib;
@@ -938,6 +939,37 @@ procedure Gnatprove with NeXTCode_Mode is
          Create (Semaphore_Name, Parallel, Why3_Semaphore);
          Ada.Environment_Variables.Set ("GNATPROVE_SEMAPHORE", Semaphore_Name);
       end if;
+
+      --  Have spark_memcached_wrapper record its lookups in the proof cache
+      --  for this run, for spark_report to summarize them, and share the
+      --  digests of the inputs of the run.
+
+      if CL_Switches.Memcached_Server /= null
+        and then CL_Switches.Memcached_Server.all /= ""
+      then
+         declare
+            Stats_File : constant String :=
+              Ada.Directories.Compose
+                (Artifact_Dir (Tree).Display_Full_Name,
+                 Cache_Client.Stats_File);
+            Memo_Dir   : constant String :=
+              Ada.Directories.Compose
+                (Artifact_Dir (Tree).Display_Full_Name,
+                 Cache_Client.Digest_Memo_Dir);
+            Success    : Boolean;
+         begin
+            GNAT.OS_Lib.Delete_File (Stats_File, Success);
+            Ada.Environment_Variables.Set
+              ("GNATPROVE_CACHE_STATS", Stats_File);
+
+            if Ada.Directories.Exists (Memo_Dir) then
+               Ada.Directories.Delete_Tree (Memo_Dir);
+            end if;
+            Ada.Environment_Variables.Set
+              ("GNATPROVE_DIGEST_MEMO", Memo_Dir);
+         end;
+      end if;
+
       return Id;
    end Spawn_VC_Server_And_Semaphore;
 
@@ -131,6 +131,54 @@ package body Report_Database is
       end if;
    end Add_Analysis_Progress;
 
+   ----------------------
+   -- Add_Cache_Lookup --
+   ----------------------
+
+   procedure Add_Cache_Lookup
+     (Tool        : String;
+      Hit         : Boolean;
+      Key_Size    : Natural;
+      Value_Size  : Natural;
+      Lookup_Time : Duration;
+      Run_Time    : Duration)
+   is
+      procedure Add (Stats : in out Cache_Stat_Rec);
+      --  Add the lookup to Stats
+
+      ---------
+      -- Add --
+      ---------
+
+      procedure Add (Stats : in out Cache_Stat_Rec) is
+      begin
+         if Hit then
+            Stats.Hits := Stats.Hits + 1;
+         else
+            Stats.Misses := Stats.Misses + 1;
+            Stats.Miss_Run_Time := Stats.Miss_Run_Time + Run_Time;
+         end if;
+
+         Stats.Key_Bytes := Stats.Key_Bytes + Long_Long_Integer (Key_Size);
+         Stats.Value_Bytes :=
+           Stats.Value_Bytes + Long_Long_Integer (Value_Size);
+         Stats.Lookup_Time := Stats.Lookup_Time + Lookup_Time;
+      end Add;
+
+      C        : Cache_Stat_Maps.Cursor;
+      Inserted : Boolean;
+
+   --  Start of processing for Add_Cache_Lookup
+
+   begin
+      Add (Cache_Stats);
+
+      if Tool /= "" then
+         Cache_Tool_Stats.Insert (Tool, Null_Cache_Stat, C, Inserted);
+         Add (Cache_Tool_Stats (C));
+      end if;
+   end Add_Cache_Lookup;
+
    --------------------------------
    -- Add_Claim_With_Assumptions --
    --------------------------------
@@ -22,9 +22,12 @@
 --
 -------------------------------------------------------------------------------
 
+with Ada.Calendar;     use Ada.Calendar;
 with Ada.Command_Line; use Ada.Command_Line;
 with Ada.Directories;
+with Ada.Environment_Variables;
 with Ada.Exceptions;
+with Ada.IO_Exceptions;
 with Ada.Strings.Fixed;
 with Ada.Text_IO;
 with Cache_Client;
@@ -35,6 +38,7 @@ with GNAT.SHA1;
 with GNAT.Sockets;     use GNAT.Sockets;
 with GNATCOLL.JSON;    use GNATCOLL.JSON;
 with GNATCOLL.Mmap;
+with Layered_Cache_Client;
 with Memcache_Client;
 
 procedure NeXTCode_Memcached_Wrapper
@@ -52,6 +56,26 @@ is
    --  The salt is an arbitrary string that is hashed as well, but is not part
    --  of the command name or command line of the tool.
 
+   --  Instead of hostname:port, the second argument may be file:directory
+   --  to use a cache in the file system, or both separated by a comma, as
+   --  in file:directory,hostname:port, to use the file cache as a local
+   --  cache in front of the memcached server. We then only connect to the
+   --  server when a key isn't in the local cache, and do without it if we
+   --  can't.
+
+   --  The input file of the tool, which can be large, is hashed separately
+   --  and its digest is added to the key. gnatprove names in the
+   --  GNATPROVE_DIGEST_MEMO environment variable a directory where the
+   --  wrappers of a run share the digests of large inputs, as a file cache
+   --  keyed by the path of the input. Each digest is stored with the
+   --  identity of the file it was computed for (device, inode, size,
+   --  modification and status change times), and only if the file hadn't
+   --  changed for a while, so that any later change gives it a different
+   --  identity.
+
+   --  The size of a file cache is limited to the number of megabytes given
+   --  by the GNATPROVE_FILE_CACHE_MAX_SIZE environment variable, if set.
+
    procedure Hash_Commandline (C : in out GNAT.SHA1.Context);
    --  @param C the hash context to be updated
    --  Compute a hash of the commandline provided to the wrapper. The procedure
@@ -70,13 +94,40 @@ is
    --  @param Fn the file to be hashed
    --  Compute a hash of the file in argument
 
+   function Input_Digest (Fn : String) return GNAT.SHA1.Message_Digest;
+   --  @param Fn the input file of the tool
+   --  @return the digest of the contents of Fn, taken from the digest memo
+   --    of the run if it has one for the current version of Fn
+
    function Compute_Key return GNAT.SHA1.Message_Digest;
    --  @return the key to be used for this invocation of the wrapper in the
    --    memcached table
 
    function Init_Client return Cache_Client.Cache'Class;
-   --  @return a connection to the memcached server specified by the first
-   --    command line argument
+   --  @return a connection to the cache specified by the second command
+   --    line argument
+
+   function Init_Tier (Info : String) return Cache_Client.Cache'Class;
+   --  @param Info the specification of a single cache, hostname:port or
+   --    file:directory
+   --  @return a connection to the cache specified by Info
+
+   function Max_File_Cache_Size return Ada.Directories.File_Size;
+   --  @return the size limit of a file cache in bytes, zero if unlimited
+
+   function To_Port (S : String) return Port_Type;
+   --  @param S the port part of a hostname:port specification
+   --  @return the port number given by S; report an error if S isn't one
+
+   procedure Record_Stats
+     (Hit         : Boolean;
+      Key_Size    : Natural;
+      Value_Size  : Natural;
+      Lookup_Time : Duration;
+      Run_Time    : Duration);
+   --  Append a line describing this lookup to the file named by the
+   --  GNATPROVE_CACHE_STATS environment variable, if set, for spark_report
+   --  to summarize. See Cache_Client.Stats_File for the format.
 
    procedure Report_Error (Msg : String)
      with No_Return;
@@ -118,9 +169,15 @@ is
 
       Hash_Fn : constant String := Compute_Hash_Filename (Execname);
    begin
-      if Hash_Fn /= "" and then Ada.Directories.Exists (Hash_Fn) then
+      --  Most binaries have no .hash file, so we just try to open it
+      --  rather than checking first whether it exists.
+
+      if Hash_Fn /= "" then
          Hash_File (C, Hash_Fn);
       end if;
+   exception
+      when Ada.IO_Exceptions.Name_Error =>
+         null;
    end Hash_Binary;
 
    ----------------------
@@ -164,6 +221,14 @@ is
    begin
       File := Open_Read (Fn);
 
+      --  There is nothing to hash in an empty file, and mapping it would
+      --  give us no data to point to.
+
+      if Length (File) = 0 then
+         Close (File);
+         return;
+      end if;
+
       Read (File, Region);
 
       declare
@@ -186,12 +251,49 @@ is
 
    function Init_Client return Cache_Client.Cache'Class is
       Info  : String renames Argument (2);
+      Comma : constant Natural :=
+        Ada.Strings.Fixed.Index (Info, ",");
+
+   begin
+      if Comma = 0 then
+         return Init_Tier (Info);
+      end if;
+
+      declare
+         First  : String renames Info (Info'First .. Comma - 1);
+         Second : String renames Info (Comma + 1 .. Info'Last);
+         Colon  : constant Natural :=
+           Ada.Strings.Fixed.Index (Second, ":");
+      begin
+         if Ada.Strings.Fixed.Head (First, 5) /= "file:" then
+            Report_Error
+              ("the local cache in option --memcached-server " &
+                 "should be of the form file:directory");
+         elsif Colon = 0 or else Ada.Strings.Fixed.Head (Second, 5) = "file:"
+         then
+            Report_Error
+              ("the remote cache in option --memcached-server " &
+                 "should be of the form hostname:portnumber");
+         end if;
+
+         --  The connection to the memcached server is only made when the
+         --  local cache misses.
+
+         return Layered_Cache_Client.Init
+           (Local    => Init_Tier (First),
+            Hostname => Second (Second'First .. Colon - 1),
+            Port     => To_Port (Second (Colon + 1 .. Second'Last)));
+      end;
+   end Init_Client;
+
+   ---------------
+   -- Init_Tier --
+   ---------------
+
+   function Init_Tier (Info : String) return Cache_Client.Cache'Class is
       Colon : constant Natural :=
         Ada.Strings.Fixed.Index (Info, ":");
 
-      Wrong_Port_Msg : constant String :=
-        ("port value should be an integer between 1 and 65535");
-
    begin
       if Colon = 0 then
          Report_Error
@@ -201,28 +303,175 @@ is
       declare
          First  : String renames Info (Info'First .. Colon - 1);
          Second : String renames Info (Colon + 1 .. Info'Last);
-         Port   : Port_Type;
       begin
          if First'Length = 4 and then First = "file" then
             if not Ada.Directories.Exists (Second) then
                Report_Error ("file caching: no such directory: " & Second);
             end if;
-            return Filecache_Client.Init (Second);
+            return Filecache_Client.Init (Second, Max_File_Cache_Size);
          else
-            begin
-               Port := Port_Type'Value (Info (Colon + 1 .. Info'Last));
-            exception
-               when Constraint_Error => Report_Error (Wrong_Port_Msg);
-            end;
+            return Memcache_Client.Init (First, To_Port (Second));
+         end if;
+      end;
+   end Init_Tier;
 
-            if Port = No_Port then
-               Report_Error (Wrong_Port_Msg);
-            else
-               return Memcache_Client.Init (First, Port);
+   ------------------
+   -- Input_Digest --
+   ------------------
+
+   function Input_Digest (Fn : String) return GNAT.SHA1.Message_Digest is
+      Memo_Var : constant String := "GNATPROVE_DIGEST_MEMO";
+
+      Min_Memo_Size : constant := 256 * 1024;
+      --  Smaller inputs are cheap enough to hash on each run
+
+      function File_Identity
+        (Path   : String;
+         Dev    : out Long_Long_Integer;
+         Ino    : out Long_Long_Integer;
+         Size   : out Long_Long_Integer;
+         Mtime  : out Long_Long_Integer;
+         Ctime  : out Long_Long_Integer;
+         Stable : out Integer) return Integer
+        with Import, Convention => C, External_Name => "file_identity";
+      --  Path is a NUL-terminated file name. See file_identity_c.c.
+
+      function File_Digest return GNAT.SHA1.Message_Digest;
+      --  Return the digest of the contents of Fn
+
+      -----------------
+      -- File_Digest --
+      -----------------
+
+      function File_Digest return GNAT.SHA1.Message_Digest is
+         C : GNAT.SHA1.Context := GNAT.SHA1.Initial_Context;
+      begin
+         Hash_File (C, Fn);
+         return GNAT.SHA1.Digest (C);
+      end File_Digest;
+
+      Dev, Ino, Size, Mtime, Ctime : Long_Long_Integer;
+      Stable                       : Integer;
+
+   --  Start of processing for Input_Digest
+
+   begin
+      if not Ada.Environment_Variables.Exists (Memo_Var)
+        or else File_Identity (Fn & ASCII.NUL, Dev, Ino, Size, Mtime, Ctime,
+                               Stable) /= 0
+        or else Size < Min_Memo_Size
+      then
+         return File_Digest;
+      end if;
+
+      declare
+         Memo     : Filecache_Client.Filecache :=
+           Filecache_Client.Init (Ada.Environment_Variables.Value (Memo_Var));
+         Key      : constant String :=
+           GNAT.SHA1.Digest (Normalize_Pathname (Fn));
+         Identity : constant String :=
+           Dev'Image & Ino'Image & Size'Image & Mtime'Image & Ctime'Image
+           & " ";
+         Known    : constant String := Memo.Get (Key);
+      begin
+         if Known'Length = Identity'Length + GNAT.SHA1.Message_Digest'Length
+           and then Ada.Strings.Fixed.Head (Known, Identity'Length) = Identity
+         then
+            Memo.Close;
+            return Ada.Strings.Fixed.Tail
+              (Known, GNAT.SHA1.Message_Digest'Length);
+         end if;
+
+         return Digest : constant GNAT.SHA1.Message_Digest := File_Digest do
+            if Stable /= 0 then
+               Memo.Set (Key, Identity & Digest);
             end if;
+            Memo.Close;
+         end return;
+      end;
+   end Input_Digest;
+
+   -------------------------
+   -- Max_File_Cache_Size --
+   -------------------------
+
+   function Max_File_Cache_Size return Ada.Directories.File_Size is
+      use type Ada.Directories.File_Size;
+
+      Var : constant String := "GNATPROVE_FILE_CACHE_MAX_SIZE";
+   begin
+      if not Ada.Environment_Variables.Exists (Var) then
+         return 0;
+      end if;
+
+      return Ada.Directories.File_Size'Value
+        (Ada.Environment_Variables.Value (Var)) * 1024 * 1024;
+   exception
+      when Constraint_Error =>
+         Report_Error
+           (Var & " should be a number of megabytes, not """
+            & Ada.Environment_Variables.Value (Var) & """");
+   end Max_File_Cache_Size;
+
+   ------------------
+   -- Record_Stats --
+   ------------------
+
+   procedure Record_Stats
+     (Hit         : Boolean;
+      Key_Size    : Natural;
+      Value_Size  : Natural;
+      Lookup_Time : Duration;
+      Run_Time    : Duration)
+   is
+      Var : constant String := "GNATPROVE_CACHE_STATS";
+
+      function Image (N : Long_Long_Integer) return String;
+      --  Return the image of N without the leading space
+
+      function Microseconds (D : Duration) return Long_Long_Integer is
+        (Long_Long_Integer (Long_Long_Float (D) * 1.0E6));
+
+      -----------
+      -- Image --
+      -----------
+
+      function Image (N : Long_Long_Integer) return String is
+         S : constant String := Long_Long_Integer'Image (N);
+      begin
+         return S (S'First + 1 .. S'Last);
+      end Image;
+
+      FD     : File_Descriptor;
+      Unused : Integer;
+
+   begin
+      if not Ada.Environment_Variables.Exists (Var) then
+         return;
+      end if;
+
+      --  The line is written with a single write to a file opened for
+      --  appending, so that the lines of concurrent runs aren't mixed up.
+      --  We identify the tool by the base name of its command, e.g.
+      --  gnatwhy3 or cvc5.
+
+      declare
+         Tool : constant String := Ada.Directories.Base_Name (Argument (3));
+         Line : constant String :=
+           (if Hit then "hit" else "miss") & ASCII.HT
+           & Image (Long_Long_Integer (Key_Size)) & ASCII.HT
+           & Image (Long_Long_Integer (Value_Size)) & ASCII.HT
+           & Image (Microseconds (Lookup_Time)) & ASCII.HT
+           & Image (Microseconds (Run_Time)) & ASCII.HT
+           & Tool & ASCII.LF;
+      begin
+         FD := Open_Append (Ada.Environment_Variables.Value (Var), Binary);
+         if FD /= Invalid_FD then
+            Unused := Write (FD, Line'Address, Line'Length);
+            Close (FD);
          end if;
       end;
-   end Init_Client;
+   end Record_Stats;
 
    ------------------
    -- Report_Error --
@@ -243,6 +492,29 @@ is
       GNAT.OS_Lib.OS_Exit (1);
    end Report_Error;
 
+   -------------
+   -- To_Port --
+   -------------
+
+   function To_Port (S : String) return Port_Type is
+      Wrong_Port_Msg : constant String :=
+        ("port value should be an integer between 1 and 65535");
+
+      Port : Port_Type;
+   begin
+      begin
+         Port := Port_Type'Value (S);
+      exception
+         when Constraint_Error => Report_Error (Wrong_Port_Msg);
+      end;
+
+      if Port = No_Port then
+         Report_Error (Wrong_Port_Msg);
+      end if;
+
+      return Port;
+   end To_Port;
+
    -----------------
    -- Compute_Key --
    -----------------
@@ -255,10 +527,9 @@ is
 
       GNAT.SHA1.Update (C, Argument (1));
 
-      --  The file is hashed separately here, it always comes last on the
-      --  command line.
+      --  The input file always comes last on the command line
 
-      Hash_File (C, Argument (Argument_Count));
+      GNAT.SHA1.Update (C, Input_Digest (Argument (Argument_Count)));
 
       --  Hash the rest of the command line
 
@@ -281,10 +552,13 @@ begin
       Cache : Cache_Client.Cache'Class := Init_Client;
 
       Key : constant String := Compute_Key;
+      Start : constant Time := Clock;
       Msg : constant String := Cache.Get (Key);
+      Lookup_Time : constant Duration := Clock - Start;
       Status : aliased Integer := 0;
    begin
       if Msg'Length /= 0 then
+         Record_Stats (True, Key'Length, Msg'Length, Lookup_Time, 0.0);
          Ada.Text_IO.Put_Line (Msg);
       else
          declare
@@ -296,12 +570,14 @@ begin
             declare
                Cmd : String renames Argument (3);
 
+               Run_Start : constant Time := Clock;
                Msg : constant String :=
                  Get_Command_Output (Cmd,
                                      Arguments,
                                      "",
                                      Status'Access,
                                      Err_To_Out => True);
+               Run_Time : constant Duration := Clock - Run_Start;
             begin
 
                --  We don't want to cache crashes of gnatwhy3; also we know
@@ -312,6 +588,8 @@ begin
                if Status = 0 or else Cmd /= "gnatwhy3" then
                   Cache.Set (Key, Msg);
                end if;
+               Record_Stats (False, Key'Length, Msg'Length, Lookup_Time,
+                             Run_Time);
                Ada.Text_IO.Put_Line (Msg);
             end;
          end;
@@ -74,11 +74,13 @@ with Ada.Calendar;
 with Ada.Containers;
 with Ada.Command_Line;
 with Ada.Directories;
+with Ada.Strings.Fixed;
 with Ada.Strings.Unbounded;               use Ada.Strings.Unbounded;
 with Ada.Text_IO;
 with Assumptions;                         use Assumptions;
 with Assumptions.Search;                  use Assumptions.Search;
 with Assumption_Types;                    use Assumption_Types;
+with Cache_Client;
 with Call;                                use Call;
 with GNAT.Calendar.Time_IO;
 with GNAT.Directory_Operations.Iteration;
@@ -134,9 +136,16 @@ procedure NeXTCode_Report is
    procedure Handle_Source_Dir (Dir : String);
    --  Parse all result files in the given directory
 
+   procedure Handle_Cache_Stats_File (Fn : String);
+   --  Parse the statistics of the proof cache written by
+   --  spark_memcached_wrapper in file Fn, if it exists.
+
    procedure Print_Analysis_Report (Handle : Ada.Text_IO.File_Type);
    --  Print the proof report in the given file
 
+   procedure Print_Cache_Stats (Handle : Ada.Text_IO.File_Type);
+   --  Print a summary of the lookups in the proof cache
+
    procedure Print_Max_Steps (Handle : Ada.Text_IO.File_Type);
    --  Print a line that summarizes the maximum required steps
 
@@ -515,6 +524,72 @@ procedure NeXTCode_Report is
       Import (RL);
    end Handle_Assume_Items;
 
+   -----------------------------
+   -- Handle_Cache_Stats_File --
+   -----------------------------
+
+   procedure Handle_Cache_Stats_File (Fn : String) is
+      use Ada.Strings.Fixed, Ada.Text_IO;
+
+      function Field (Line : String; N : Positive) return String;
+      --  Return the Nth tab-separated field of Line
+
+      function To_Duration (Microseconds : String) return Duration is
+        (Duration (Long_Long_Float'Value (Microseconds) / 1.0E6));
+
+      -----------
+      -- Field --
+      -----------
+
+      function Field (Line : String; N : Positive) return String is
+         First : Positive := Line'First;
+         Tab   : Natural;
+      begin
+         for J in 1 .. N - 1 loop
+            Tab := Index (Line (First .. Line'Last), [ASCII.HT]);
+            if Tab = 0 then
+               return "";
+            end if;
+
+            First := Tab + 1;
+         end loop;
+
+         Tab := Index (Line (First .. Line'Last), [ASCII.HT]);
+         return Line (First .. (if Tab = 0 then Line'Last else Tab - 1));
+      end Field;
+
+      File : File_Type;
+
+   --  Start of processing for Handle_Cache_Stats_File
+
+   begin
+      if not Ada.Directories.Exists (Fn) then
+         return;
+      end if;
+
+      Open (File, In_File, Fn);
+      while not End_Of_File (File) loop
+         declare
+            Line : constant String := Get_Line (File);
+         begin
+            Add_Cache_Lookup
+              (Tool        => Field (Line, 6),
+               Hit         => Field (Line, 1) = "hit",
+               Key_Size    => Natural'Value (Field (Line, 2)),
+               Value_Size  => Natural'Value (Field (Line, 3)),
+               Lookup_Time => To_Duration (Field (Line, 4)),
+               Run_Time    => To_Duration (Field (Line, 5)));
+
+         --  Skip lines that were only partially written, if any
+
+         exception
+            when Constraint_Error =>
+               null;
+         end;
+      end loop;
+      Close (File);
+   end Handle_Cache_Stats_File;
+
    -----------------------
    -- Handle_Flow_Items --
    -----------------------
@@ -1085,6 +1160,81 @@ procedure NeXTCode_Report is
       end if;
    end Print_Analysis_Report;
 
+   -----------------------
+   -- Print_Cache_Stats --
+   -----------------------
+
+   procedure Print_Cache_Stats (Handle : Ada.Text_IO.File_Type) is
+      use Ada.Text_IO;
+
+      function Microseconds (D : Duration) return Long_Long_Integer is
+        (Long_Long_Integer (Long_Long_Float (D) * 1.0E6));
+
+      Stats   : Cache_Stat_Rec renames Cache_Stats;
+      Lookups : constant Natural := Stats.Hits + Stats.Misses;
+
+   begin
+      Put_Line (Handle, "===========");
+      Put_Line (Handle, "Proof cache");
+      Put_Line (Handle, "===========");
+      New_Line (Handle);
+
+      Put_Line
+        (Handle,
+         f"lookups: {Lookups}, hits: {Stats.Hits} "
+         & f"({Stats.Hits * 100 / Lookups}%), misses: {Stats.Misses}");
+      Put_Line
+        (Handle,
+         "average key size: "
+         & f"{Stats.Key_Bytes / Long_Long_Integer (Lookups)} bytes, "
+         & "average value size: "
+         & f"{Stats.Value_Bytes / Long_Long_Integer (Lookups)} bytes");
+      Put_Line
+        (Handle,
+         "average lookup time: "
+         & f"{Microseconds (Stats.Lookup_Time / Lookups)} microseconds");
+
+      --  We estimate the time saved by a hit as the average time taken by
+      --  the tools on a miss.
+
+      if Stats.Misses > 0 then
+         declare
+            Run_Time : constant Long_Long_Integer :=
+              Microseconds (Stats.Miss_Run_Time);
+            Saved    : constant Long_Long_Integer :=
+              Run_Time * Long_Long_Integer (Stats.Hits)
+                / Long_Long_Integer (Stats.Misses) / 1_000_000;
+         begin
+            Put_Line
+              (Handle,
+               "time spent running tools on misses: "
+               & f"{Run_Time / 1_000_000} seconds");
+            Put_Line
+              (Handle, f"estimated time saved by hits: {Saved} seconds");
+         end;
+      end if;
+
+      --  Then break the lookups down per tool
+
+      for C in Cache_Tool_Stats.Iterate loop
+         declare
+            Tool         : constant String := Cache_Stat_Maps.Key (C);
+            Tool_Stats   : Cache_Stat_Rec renames Cache_Tool_Stats (C);
+            Tool_Lookups : constant Natural :=
+              Tool_Stats.Hits + Tool_Stats.Misses;
+         begin
+            Put_Line
+              (Handle,
+               f"  {Tool}: lookups: {Tool_Lookups}, "
+               & f"hits: {Tool_Stats.Hits} "
+               & f"({Tool_Stats.Hits * 100 / Tool_Lookups}%), "
+               & f"misses: {Tool_Stats.Misses}");
+         end;
+      end loop;
+
+      New_Line (Handle);
+   end Print_Cache_Stats;
+
    ---------------------
    -- Print_Max_Steps --
    ---------------------
@@ -1409,6 +1559,11 @@ begin
       end;
    end if;
 
+   Handle_Cache_Stats_File
+     (Ada.Directories.Compose
+        (GNAT.Directory_Operations.Dir_Name (Source_Directories_File),
+         Cache_Client.Stats_File));
+
    Create (Handle,
            Out_File,
            Ada.Directories.Compose
@@ -1471,6 +1626,10 @@ begin
       end if;
    end if;
 
+   if Cache_Stats.Hits + Cache_Stats.Misses > 0 then
+      Print_Cache_Stats (Handle);
+   end if;
+
    Print_Most_Difficult_Proved_Checks (Handle);
    Print_Analysis_Report (Handle);
    Close (Handle);
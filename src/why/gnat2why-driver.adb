@@ -169,6 +169,11 @@ package body Gnat2Why.Driver is
    function Get_Skip_Flow_And_Proof_JSON return JSON_Array;
    --  Return a list of entities for which flow and proof was skipped.
 
+   function Get_Sources_JSON return JSON_Array;
+   --  Return the name and the SHA-1 digest of the contents of each source
+   --  file of the unit, which lets users of the results of the analysis
+   --  check they are up to date.
+
    procedure Generate_Assumptions;
    --  For all calls from a NeXTCode subprogram to another, register assumptions
 
@@ -364,6 +369,7 @@ package body Gnat2Why.Driver is
          Set_Field (Full, "proof", Create (Get_Proof_JSON));
       end if;
       Set_Field (Full, "assumptions", Get_Assume_JSON);
+      Set_Field (Full, "sources", Get_Sources_JSON);
 
       Set_Field (Full, "timings", Timing_History (Timing));
       Set_Field (Full, "entities", Entity_Table);
@@ -1038,6 +1044,37 @@ package body Gnat2Why.Driver is
       return Result;
    end Get_Skip_Proof_JSON;
 
+   ----------------------
+   -- Get_Sources_JSON --
+   ----------------------
+
+   function Get_Sources_JSON return JSON_Array is
+      Result : JSON_Array := Empty_Array;
+   begin
+      for SFI in 1 .. Last_Source_File loop
+
+         --  Instances share the file of their generic. We record a digest
+         --  of the exact contents of each file rather than its checksum,
+         --  which ignores comments and blank lines, as these still move
+         --  the locations by which the results identify checks.
+
+         if Instantiation (SFI) = No_Location then
+            declare
+               Source : constant JSON_Value := Create_Object;
+            begin
+               Set_Field (Source, "file", Get_Name_String (File_Name (SFI)));
+               Set_Field
+                 (Source, "sha1",
+                  GNAT.SHA1.Digest
+                    (Read_File_Into_String
+                       (Get_Name_String (Full_File_Name (SFI)))));
+               Append (Result, Source);
+            end;
+         end if;
+      end loop;
+      return Result;
+   end Get_Sources_JSON;
+
    ------------------------
    -- Is_Back_End_Switch --
    ------------------------